@@ -0,0 +1,93 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../gameEngine.h"
+using namespace std;
+
+// Helpers shared by the benchmarks in this directory: timers, percentiles, the maze board, game
+// comparison and the pass/fail checks that give a bench its exit code.
+
+// Returns the milliseconds elapsed since 'start'
+inline double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// Returns the microseconds elapsed since 'start'
+inline double microsecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+}
+
+// Returns the nanoseconds elapsed since 'start'
+inline double nanosecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+}
+
+// Returns the value below which 'percent' of the sorted samples fall (nearest rank)
+inline double percentile(const vector<double>& sorted, double percent) {
+    size_t rank = (size_t)ceil(percent / 100 * sorted.size());
+    return sorted[min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+}
+
+// Builds walls of mines on every fourth row, each with a three-tile gap at alternating ends,
+// so the empty region is one long corridor that snakes through the whole board
+inline void buildMaze(BoardCore& core) {
+    for (int i = 3; i < core.rows; i += 4) {
+        bool gapOnRight = (i / 4) % 2 == 0;
+        for (int j = 0; j < core.columns; j++) {
+            bool inGap = gapOnRight ? j >= core.columns - 3 : j < 3;
+            if (!inGap) core.setMine(core.index(i, j));
+        }
+    }
+}
+
+// Returns whether two engines hold the same game in every detail a save keeps: size, counters,
+// win/lose state and tiles (not the seed or the random stream)
+inline bool sameGame(const GameEngine& a, const GameEngine& b) {
+    return a.rows == b.rows && a.columns == b.columns && a.mineCount == b.mineCount && a.placeFlagging == b.placeFlagging &&
+           a.loser == b.loser && a.winner == b.winner && a.core.minesPlaced == b.core.minesPlaced && a.core.state == b.core.state &&
+           a.core.revealedSafeTiles == b.core.revealedSafeTiles && a.core.flagsPlaced == b.core.flagsPlaced &&
+           a.core.correctFlags == b.core.correctFlags;
+}
+
+// The BenchChecks class collects the pass/fail checks of a bench. Each check is printed as it is
+// made, or, when the bench prefers its timings first, all of them at the end by report().
+class BenchChecks {
+    // Private member variables:
+    int nameWidth;                       // Width of the check name column.
+    bool printEach;                      // Indicates whether checks are printed as they are made.
+    bool allPassed = true;               // Indicates whether every check so far passed.
+    vector<pair<string, bool>> pending;  // Checks waiting for report().
+
+    // Prints one check line.
+    void print(const string& name, bool passed) const {
+        cout << "  " << left << setw(nameWidth) << name << (passed ? "ok" : "FAILED") << endl;
+    }
+
+public:
+    // Constructor: checks are printed with their names padded to 'width', right away if 'printNow'.
+    explicit BenchChecks(int width, bool printNow = false) : nameWidth(width), printEach(printNow) {}
+
+    // Records the result of a check.
+    void check(const string& name, bool passed) {
+        allPassed = allPassed && passed;
+        if (printEach) print(name, passed);
+        else pending.push_back({name, passed});
+    }
+
+    // Prints the checks not printed yet under "Checks:" and returns the exit code of the bench
+    // (1 if any check failed).
+    int report() {
+        if (!pending.empty()) {
+            cout << endl << "Checks:" << endl;
+            for (const auto& result : pending) print(result.first, result.second);
+            pending.clear();
+        }
+        return allPassed ? 0 : 1;
+    }
+};
@@ -0,0 +1,303 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+#include "../gameHelp.h"
+#include "../leaderboard.h"
+#include "benchCommon.h"
+#include <SFML/Graphics.hpp>
+using namespace std;
+using namespace sf;
+
+// Benchmark suite for the engine and the renderer: board construction and generation at several
+// sizes and densities, reveals (best case: one numbered tile; worst case: a flood fill of the
+// whole board), the win check, flag toggling, leaderboard load and save, and Board::draw into an
+// off-screen RenderTexture. Every case is sampled many times and reports the median and p99 time
+// per operation and the heap allocations and bytes per operation (counted by replacing the
+// global operator new). Results can be written as CSV and JSON to compare runs over time.
+//
+// Usage: benchSuite [--filter text] [--samples N] [--label text] [--csv file] [--json file]
+//   --filter   runs only the cases whose name contains 'text'
+//   --samples  samples per case (default 200; fewer for the slowest cases)
+//   --label    tag stored with every result (e.g. a commit or a machine name)
+//   --csv      appends the results to a CSV file (the header is written when the file is new)
+//   --json     writes the results to a JSON file
+//
+// Must be run from the game directory (the draw cases load the tile images). Built, like the game,
+// against an engine compiled with -DNDEBUG (the Makefile's DEBUGFLAGS), so the checkIfWinner case
+// measures the running-counter check that ships, not the debug build's full-board scan.
+
+// Heap allocations made by the process, counted by the operator new replacements below
+static atomic<long long> allocationCount(0);
+static atomic<long long> allocatedBytes(0);
+
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    allocatedBytes.fetch_add((long long)size, memory_order_relaxed);
+    if (void* memory = malloc(size ? size : 1)) return memory;
+    throw bad_alloc();
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* memory) noexcept { free(memory); }
+void operator delete[](void* memory) noexcept { free(memory); }
+void operator delete(void* memory, size_t) noexcept { free(memory); }
+void operator delete[](void* memory, size_t) noexcept { free(memory); }
+
+// The BenchResult struct is the summary of one case.
+struct BenchResult {
+    string name;                // Case name (e.g. "reveal/worst").
+    string parameters;          // Board or data set it ran on (e.g. "1000x1000x1").
+    int samples = 0;            // Number of timed samples.
+    int batch = 0;              // Operations per sample.
+    double medianNs = 0;        // Median time per operation.
+    double p99Ns = 0;           // 99th percentile time per operation.
+    double meanNs = 0;          // Mean time per operation.
+    double allocationsPerOp = 0; // Heap allocations per operation.
+    double bytesPerOp = 0;       // Heap bytes allocated per operation.
+};
+
+// Runs 'samples' samples of a case: each calls 'setup' untimed, then times 'batch' calls of
+// 'operation' (batching keeps operations shorter than the clock's resolution measurable)
+template <typename Setup, typename Operation>
+BenchResult measure(const string& name, const string& parameters, int samples, int batch, Setup setup, Operation operation) {
+    BenchResult result;
+    result.name = name;
+    result.parameters = parameters;
+    result.samples = samples;
+    result.batch = batch;
+
+    vector<double> times;
+    times.reserve(samples);
+    long long allocations = 0, bytes = 0;
+    for (int sample = 0; sample < samples; sample++) {
+        setup();
+        long long allocationsBefore = allocationCount.load(), bytesBefore = allocatedBytes.load();
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < batch; i++) operation(i);
+        double elapsed = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+        allocations += allocationCount.load() - allocationsBefore;
+        bytes += allocatedBytes.load() - bytesBefore;
+        times.push_back(elapsed / batch);
+    }
+
+    sort(times.begin(), times.end());
+    result.medianNs = percentile(times, 50);
+    result.p99Ns = percentile(times, 99);
+    for (double time : times) result.meanNs += time / samples;
+    result.allocationsPerOp = (double)allocations / ((double)samples * batch);
+    result.bytesPerOp = (double)bytes / ((double)samples * batch);
+    return result;
+}
+
+// Formats nanoseconds with a unit that keeps three or four significant digits
+string formatTime(double nanoseconds) {
+    char text[32];
+    if (nanoseconds < 1e3) snprintf(text, sizeof(text), "%.1f ns", nanoseconds);
+    else if (nanoseconds < 1e6) snprintf(text, sizeof(text), "%.2f us", nanoseconds / 1e3);
+    else snprintf(text, sizeof(text), "%.2f ms", nanoseconds / 1e6);
+    return text;
+}
+
+// Returns "columnsxrowsxmines"
+string boardName(const BoardConfig& config) {
+    return to_string(config.columns) + "x" + to_string(config.rows) + "x" + to_string(config.mineCount);
+}
+
+// Returns the index of a hidden, safe tile that shows a number, or -1 if none is left
+int hiddenNumberTile(const Board& board) {
+    for (int i = 0; i < board.tiles; i++) {
+        uint8_t tile = board.core.state[i];
+        if (!(tile & (TILE_REVEALED | TILE_MINE)) && (tile & TILE_COUNT_MASK)) return i;
+    }
+    return -1;
+}
+
+// Writes 'count' wins in the store's file format
+void writeLeaderboardFile(const string& path, int count) {
+    mt19937 rng(42);
+    ofstream file(path, ios::trunc);
+    for (int i = 0; i < count; i++) {
+        int seconds = 30 + rng() % 3600;
+        file << (seconds / 60 < 10 ? "0" : "") << seconds / 60 << ":" << (seconds % 60 < 10 ? "0" : "") << seconds % 60
+             << ",Player" << i % 1000 << ",30x16x99\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    string filter, label, csvPath, jsonPath;
+    int samples = 200;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string option = argv[i];
+        if (option == "--filter") filter = argv[i + 1];
+        else if (option == "--samples") samples = max(1, stoi(argv[i + 1]));
+        else if (option == "--label") label = argv[i + 1];
+        else if (option == "--csv") csvPath = argv[i + 1];
+        else if (option == "--json") jsonPath = argv[i + 1];
+    }
+    int slowSamples = max(1, samples / 10); // For cases that take tens of milliseconds
+
+    vector<BenchResult> results;
+    auto report = [&](const BenchResult& result) {
+        cout << left << setw(24) << result.name << setw(16) << result.parameters << right << setw(12) << formatTime(result.medianNs)
+             << setw(12) << formatTime(result.p99Ns) << setw(12) << fixed << setprecision(2) << result.allocationsPerOp << setw(14)
+             << setprecision(0) << result.bytesPerOp << endl;
+        results.push_back(result);
+    };
+    auto wanted = [&](const string& name) { return filter.empty() || name.find(filter) != string::npos; };
+
+    cout << left << setw(24) << "case" << setw(16) << "board" << right << setw(12) << "median" << setw(12) << "p99" << setw(12)
+         << "allocs/op" << setw(14) << "bytes/op" << endl;
+
+    // Construction, and construction plus the first reveal (which places the mines), by size and density
+    const BoardConfig boards[] = {{9, 9, 10}, {16, 16, 40}, {30, 16, 99}, {100, 100, 1000}, {100, 100, 2060},
+                                  {100, 100, 3000}, {1000, 1000, 206000}};
+    uint32_t seed = 1;
+    for (const BoardConfig& config : boards) {
+        bool large = config.columns * config.rows >= 1000000;
+        if (wanted("construct")) {
+            report(measure("construct", boardName(config), large ? slowSamples : samples, large ? 1 : 10, [] {},
+                           [&](int) { Board board(config, seed++); }));
+        }
+        if (wanted("construct+first reveal")) {
+            report(measure("construct+first reveal", boardName(config), large ? slowSamples : samples, 1, [] {}, [&](int) {
+                Board board(config, seed++);
+                board.reveal(board.core.index(config.rows / 2, config.columns / 2));
+            }));
+        }
+    }
+
+    // Best case: one numbered tile; worst case: a board with one mine, where one reveal opens everything
+    const BoardConfig revealBoards[] = {{30, 16, 99}, {1000, 1000, 206000}};
+    for (const BoardConfig& config : revealBoards) {
+        if (!wanted("reveal/best")) break;
+        Board board(config, 7);
+        board.reveal(board.core.index(config.rows / 2, config.columns / 2));
+        int target = -1;
+        report(measure("reveal/best", boardName(config), samples, 1,
+                       [&] {
+                           target = hiddenNumberTile(board);
+                           if (target < 0) { // Every number is open: start a new board
+                               board.restart(config, seed++);
+                               board.reveal(board.core.index(config.rows / 2, config.columns / 2));
+                               target = hiddenNumberTile(board);
+                           }
+                       },
+                       [&](int) { board.reveal(target); }));
+    }
+    const BoardConfig floodBoards[] = {{30, 16, 1}, {1000, 1000, 1}};
+    for (const BoardConfig& config : floodBoards) {
+        if (!wanted("reveal/worst")) break;
+        bool large = config.columns * config.rows >= 1000000;
+        Board board(config, 7);
+        int corner = 0;
+        report(measure("reveal/worst", boardName(config), large ? slowSamples : samples, 1,
+                       [&] {
+                           board.restart(config, seed++);
+                           board.core.placeMines(1, board.rng, corner); // The mines are placed untimed
+                       },
+                       [&](int) { board.reveal(corner); }));
+    }
+
+    // The win check and flag toggling on an expert board in play
+    {
+        BoardConfig config{30, 16, 99};
+        Board board(config, 11);
+        board.reveal(board.core.index(8, 15));
+        if (wanted("checkIfWinner")) {
+            report(measure("checkIfWinner", boardName(config), samples, 1000, [] {}, [&](int) { board.checkIfWinner(); }));
+        }
+        vector<int> hidden;
+        for (int i = 0; i < board.tiles; i++) {
+            if (!board.core.isRevealed(i)) hidden.push_back(i);
+        }
+        if (wanted("toggleFlag")) {
+            report(measure("toggleFlag", boardName(config), samples, 1000, [] {},
+                           [&](int i) { board.toggleFlag(hidden[i % hidden.size()]); }));
+        }
+    }
+
+    // Leaderboard load and save (appending one win; the p99 shows the occasional compaction)
+    const string leaderboardPath = "benchSuite-leaderboard.txt";
+    const int leaderboardSizes[] = {1000, 100000};
+    for (int size : leaderboardSizes) {
+        if (!wanted("leaderboard/load") && !wanted("leaderboard/save")) break;
+        writeLeaderboardFile(leaderboardPath, size);
+        string wins = to_string(size) + " wins";
+        int loadSamples = size >= 100000 ? slowSamples : samples;
+        if (wanted("leaderboard/load")) {
+            report(measure("leaderboard/load", wins, loadSamples, 1, [] {},
+                           [&](int) { LeaderboardStore store(leaderboardPath, "30x16x99"); }));
+        }
+        if (wanted("leaderboard/save")) {
+            LeaderboardStore store(leaderboardPath, "30x16x99");
+            report(measure("leaderboard/save", wins, samples, 1, [] {},
+                           [&](int i) { store.addScore("30x16x99", 30 + i % 3600, "Bench"); }));
+        }
+    }
+    remove(leaderboardPath.c_str());
+    remove((leaderboardPath + ".tmp").c_str());
+
+    // Drawing through a 1280x720 camera into an off-screen texture: a frame with nothing changed,
+    // and a frame where every visible quad is rewritten (as after a pan or a change of mode)
+    if (wanted("draw/still") || wanted("draw/rewrite")) {
+        RenderTexture target;
+        target.create(1280, 720);
+        TextureCache::instance().tileAtlas();
+        const BoardConfig drawBoards[] = {{30, 16, 99}, {1000, 1000, 206000}};
+        for (const BoardConfig& config : drawBoards) {
+            Board board(config, 5);
+            board.reveal(board.core.index(config.rows / 2, config.columns / 2));
+            BoardCamera camera(1280, 720, 1280, 720, config.columns, config.rows);
+            target.setView(camera.getView());
+            board.draw(target, camera.visibleTiles());
+            if (wanted("draw/still")) {
+                report(measure("draw/still", boardName(config), samples, 10, [] {},
+                               [&](int) { board.draw(target, camera.visibleTiles()); }));
+            }
+            if (wanted("draw/rewrite")) {
+                report(measure("draw/rewrite", boardName(config), samples, 1, [&] { board.renderer.allTilesChanged(); },
+                               [&](int) { board.draw(target, camera.visibleTiles()); }));
+            }
+        }
+    }
+
+    // Machine-readable copies of the results
+    time_t now = time(nullptr);
+    char timestamp[32];
+    strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+    if (!csvPath.empty()) {
+        bool newFile = !ifstream(csvPath).good();
+        ofstream csv(csvPath, ios::app);
+        if (newFile) csv << "timestamp,label,case,board,samples,batch,median_ns,p99_ns,mean_ns,allocs_per_op,bytes_per_op\n";
+        for (const BenchResult& result : results) {
+            csv << timestamp << "," << label << "," << result.name << "," << result.parameters << "," << result.samples << ","
+                << result.batch << "," << fixed << setprecision(1) << result.medianNs << "," << result.p99Ns << "," << result.meanNs
+                << "," << setprecision(3) << result.allocationsPerOp << "," << setprecision(1) << result.bytesPerOp << "\n";
+        }
+        cout << "Results appended to " << csvPath << endl;
+    }
+    if (!jsonPath.empty()) {
+        ofstream json(jsonPath, ios::trunc);
+        json << "{\"timestamp\":\"" << timestamp << "\",\"label\":\"" << label << "\",\"results\":[";
+        for (size_t i = 0; i < results.size(); i++) {
+            const BenchResult& result = results[i];
+            json << (i ? "," : "") << "\n{\"case\":\"" << result.name << "\",\"board\":\"" << result.parameters << "\",\"samples\":"
+                 << result.samples << ",\"batch\":" << result.batch << fixed << setprecision(1) << ",\"median_ns\":" << result.medianNs
+                 << ",\"p99_ns\":" << result.p99Ns << ",\"mean_ns\":" << result.meanNs << setprecision(3)
+                 << ",\"allocs_per_op\":" << result.allocationsPerOp << setprecision(1) << ",\"bytes_per_op\":" << result.bytesPerOp << "}";
+        }
+        json << "\n]}\n";
+        cout << "Results written to " << jsonPath << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include "../bitBoard.h"
+#include "benchCommon.h"
+using namespace std;
+
+// Compares the bitplane kernels with the byte-per-tile engine on boards of 1 and 4 million tiles:
+// counting nearby mines (the byte-by-byte sliding sum against the bit-sliced count with the scalar
+// and, if the CPU has it, the AVX2 kernels; BoardCore::countNearbyMines uses the bit-sliced count
+// on boards this wide), a single reveal that floods an empty board and a serpentine maze, and a
+// whole game at expert density (every safe tile clicked in a random order).
+// Checks that every result matches the byte engine bit for bit: the same state bytes, counters and
+// revealed tiles. Exits with an error if a check fails.
+//
+// Usage: bitBoardBench [side] (default 1000 and 2048, one side gives a single board of side x side)
+
+// Returns whether a bitboard stores exactly the tiles and counters of 'core'
+bool sameBoard(const BitBoard& bits, const BoardCore& core) {
+    BoardCore stored;
+    bits.store(stored);
+    return stored.state == core.state && stored.revealedSafeTiles == core.revealedSafeTiles &&
+           stored.flagsPlaced == core.flagsPlaced && stored.correctFlags == core.correctFlags;
+}
+
+// Returns whether two lists hold the same tiles (the bitboard lists them row by row, the byte engine breadth-first)
+bool sameTiles(vector<int> a, vector<int> b) {
+    sort(a.begin(), a.end());
+    sort(b.begin(), b.end());
+    return a == b;
+}
+
+int main(int argc, char* argv[]) {
+    vector<int> sides = {1000, 2048};
+    if (argc > 1) sides = {stoi(argv[1])};
+    const BitKernels* avx2 = avx2BitKernels();
+    vector<const BitKernels*> kernelSets = {&SCALAR_BIT_KERNELS};
+    if (avx2) kernelSets.push_back(avx2);
+    cout << "Bit kernels: " << bestBitKernels()->name << " picked at run time (AVX2 " << (avx2 ? "available" : "not available") << ")" << endl;
+
+    BenchChecks checks(60);
+
+    for (int side : sides) {
+        long long tiles = (long long)side * side;
+        cout << endl << side << "x" << side << " (" << tiles / 1000000.0 << " million tiles)" << endl;
+
+        // Nearby mines at expert density
+        BoardCore layout;
+        layout.resize(side, side);
+        mt19937 rng(side);
+        for (long long i = 0; i < tiles; i++) {
+            if (rng() % 480 < 99) layout.setMine((int)i);
+        }
+        BoardCore bytes = layout;
+        vector<uint8_t> columnMines(side + 2, 0), emptyRow(side, 0);
+        auto start = chrono::steady_clock::now();
+        BoardCore::countNearbyMinesWith(bytes.state.data(), side, side, columnMines.data(), emptyRow.data());
+        double byteMs = millisecondsSince(start);
+        cout << "  count nearby mines: byte engine " << fixed << setprecision(2) << byteMs << " ms";
+        for (const BitKernels* kernels : kernelSets) {
+            BoardCore counted = layout;
+            start = chrono::steady_clock::now();
+            countNearbyMinesBitwise(counted, kernels);
+            double bitMs = millisecondsSince(start);
+            cout << ", bitplanes (" << kernels->name << ") " << bitMs << " ms";
+            checks.check(string("bitplane counts (") + kernels->name + ") match the byte engine", counted.state == bytes.state);
+
+            BitBoard board;
+            board.kernels = kernels;
+            board.resize(side, side);
+            for (long long i = 0; i < tiles; i++) {
+                if (layout.isMine((int)i)) board.setMine((int)i);
+            }
+            start = chrono::steady_clock::now();
+            board.countNearbyMines();
+            double planeMs = millisecondsSince(start);
+            cout << " (" << planeMs << " ms plane to plane)";
+            checks.check(string("BitBoard counts (") + kernels->name + ") match the byte engine", sameBoard(board, bytes));
+        }
+        cout << endl;
+
+        // One click flooding an empty board and a maze, from the top-left corner
+        for (int maze = 0; maze < 2; maze++) {
+            BoardCore core;
+            core.resize(side, side);
+            if (maze) buildMaze(core);
+            core.countNearbyMines();
+            BitBoard board;
+            board.load(core);
+
+            vector<int> byteTiles, bitTiles;
+            byteTiles.reserve(tiles);
+            bitTiles.reserve(tiles);
+            start = chrono::steady_clock::now();
+            core.reveal(core.index(1, 1), byteTiles);
+            double byteRevealMs = millisecondsSince(start);
+            start = chrono::steady_clock::now();
+            board.reveal(core.index(1, 1), bitTiles);
+            double bitRevealMs = millisecondsSince(start);
+            const char* name = maze ? "maze" : "empty board";
+            cout << "  reveal " << left << setw(12) << name << right << byteTiles.size() << " tiles: byte engine " << byteRevealMs
+                 << " ms, bitplanes " << bitRevealMs << " ms" << endl;
+            checks.check(string("one reveal of the ") + name + " matches the byte engine", sameBoard(board, core) && sameTiles(byteTiles, bitTiles));
+        }
+
+        // A whole game: every safe tile clicked in a random order, with some flags placed first
+        BoardCore core = bytes;
+        for (long long i = 0; i < tiles; i += 37) {
+            if (core.isMine((int)i) || i % 3 == 0) core.toggleFlag((int)i);
+        }
+        BitBoard board;
+        board.load(core);
+        vector<int> clicks;
+        for (long long i = 0; i < tiles; i++) {
+            if (!core.isMine((int)i)) clicks.push_back((int)i);
+        }
+        shuffle(clicks.begin(), clicks.end(), rng);
+        vector<int> byteTiles, bitTiles;
+        long long reveals = 0;
+        start = chrono::steady_clock::now();
+        for (int click : clicks) {
+            if (core.isRevealed(click) || core.isFlagged(click)) continue;
+            core.reveal(click, byteTiles);
+            reveals++;
+        }
+        double byteGameMs = millisecondsSince(start);
+        start = chrono::steady_clock::now();
+        for (int click : clicks) {
+            size_t at = board.word(click / side, click % side);
+            uint64_t tile = BitBoard::bit(click % side);
+            if ((board.revealed[at] | board.flagged[at]) & tile) continue;
+            board.reveal(click, bitTiles);
+        }
+        double bitGameMs = millisecondsSince(start);
+        cout << "  whole game (" << reveals << " reveals): byte engine " << byteGameMs << " ms, bitplanes " << bitGameMs << " ms" << endl;
+        checks.check("a whole game matches the byte engine", sameBoard(board, core) && sameTiles(byteTiles, bitTiles));
+    }
+
+    return checks.report();
+}
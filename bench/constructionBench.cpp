@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../bitBoard.h"
+#include "../workStealingPool.h"
+#include "benchCommon.h"
+using namespace std;
+
+// Times building a huge board at expert density (mines placed and nearby mines counted) with the
+// banded construction on pools of 1, 2, 4, ... threads, against the serial selection sampling and
+// count that built huge boards before. Allocating the tiles is timed apart: it stays serial.
+// Checks that every thread count (and no pool at all) builds exactly the same tiles, that the
+// board has exactly the requested mines and none in the safe zone, that the counts match the byte
+// engine, and that on a small board cut into many bands every candidate tile is equally likely to
+// get a mine (chi-square test of the per-tile frequencies). Exits with an error if a check fails.
+//
+// Usage: constructionBench [side] [samples] (default 10000, giving 100 million tiles, and 100000)
+
+// Returns an FNV-1a hash of the state bytes
+uint64_t hashState(const BoardCore& core) {
+    uint64_t hash = 14695981039346656037ull;
+    for (uint8_t tile : core.state) hash = (hash ^ tile) * 1099511628211ull;
+    return hash;
+}
+
+// Returns the chi-square statistic of the mine frequency of every candidate tile over 'samples'
+// boards built in bands of 'bandRows' rows, and sets 'zoneClear' if no mine ever landed in the safe zone
+double mineFrequencyChiSquare(int rows, int columns, int mines, int safeIndex, int bandRows, int samples, int& candidates, bool& zoneClear) {
+    vector<long long> hits(rows * columns, 0);
+    vector<char> inZone(rows * columns, 0);
+    BoardCore core;
+    core.resize(rows, columns);
+    if (safeIndex >= 0) {
+        inZone[safeIndex] = 1;
+        core.forEachNeighbor(safeIndex, [&](int neighbor) { inZone[neighbor] = 1; });
+    }
+    mt19937 rng(rows * 100 + columns);
+    for (int s = 0; s < samples; s++) {
+        core.resize(rows, columns);
+        core.placeMinesInBands(mines, rng, safeIndex, nullptr, bandRows);
+        for (int i = 0; i < rows * columns; i++) hits[i] += core.isMine(i);
+    }
+
+    candidates = 0;
+    zoneClear = true;
+    for (int i = 0; i < rows * columns; i++) {
+        if (inZone[i]) zoneClear = zoneClear && hits[i] == 0;
+        else candidates++;
+    }
+    double expected = (double)samples * mines / candidates;
+    double chiSquare = 0;
+    for (int i = 0; i < rows * columns; i++) {
+        if (!inZone[i]) chiSquare += (hits[i] - expected) * (hits[i] - expected) / expected;
+    }
+    return chiSquare;
+}
+
+int main(int argc, char* argv[]) {
+    int side = argc > 1 ? stoi(argv[1]) : 10000;
+    int samples = argc > 2 ? stoi(argv[2]) : 100000;
+    long long tiles = (long long)side * side;
+    int mines = (int)(tiles * 99 / 480);
+    int safeIndex = (side / 2) * side + side / 2;
+    const uint32_t seed = 2024;
+
+    BenchChecks checks(68);
+
+    cout << side << "x" << side << " (" << tiles / 1000000.0 << " million tiles, " << mines << " mines), "
+         << thread::hardware_concurrency() << " hardware threads" << endl;
+
+    // The serial build: selection sampling over every tile, then the whole-board count
+    BoardCore serial;
+    auto start = chrono::steady_clock::now();
+    serial.resize(side, side);
+    double allocateMs = millisecondsSince(start);
+    mt19937 serialRng(seed);
+    start = chrono::steady_clock::now();
+    serial.placeMinesInPlace(mines, serialRng, safeIndex);
+    double serialMs = millisecondsSince(start);
+    cout << "  allocate tiles (serial): " << fixed << setprecision(1) << allocateMs << " ms" << endl;
+    cout << "  serial place + count: " << serialMs << " ms" << endl;
+    serial = BoardCore(); // Frees its tiles before the next build
+
+    // The banded build on the calling thread, then on pools of growing size
+    BoardCore banded;
+    banded.resize(side, side);
+    mt19937 inlineRng(seed);
+    start = chrono::steady_clock::now();
+    banded.placeMinesInBands(mines, inlineRng, safeIndex);
+    double inlineMs = millisecondsSince(start);
+    uint64_t expectedHash = hashState(banded);
+    cout << "  bands, no pool: " << inlineMs << " ms (" << serialMs / inlineMs << "x serial)" << endl;
+
+    int mineTiles = 0;
+    for (uint8_t tile : banded.state) mineTiles += (tile & TILE_MINE) != 0;
+    bool zoneClear = !banded.isMine(safeIndex);
+    banded.forEachNeighbor(safeIndex, [&](int neighbor) { zoneClear = zoneClear && !banded.isMine(neighbor); });
+    checks.check("the board has exactly the requested mines", mineTiles == mines && banded.minesPlaced);
+    checks.check("no mine lands in the safe zone", zoneClear);
+
+    // The counts must match the byte engine on the same mines
+    BoardCore recounted = banded;
+    for (uint8_t& tile : recounted.state) tile &= ~TILE_COUNT_MASK;
+    vector<uint8_t> columnMines(side + 2, 0), emptyRow(side, 0);
+    BoardCore::countNearbyMinesWith(recounted.state.data(), side, side, columnMines.data(), emptyRow.data());
+    checks.check("nearby mine counts match the byte engine", recounted.state == banded.state);
+    recounted = BoardCore();
+
+    int maxThreads = max(4, (int)thread::hardware_concurrency());
+    bool sameLayouts = true;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        WorkStealingPool pool(threads);
+        banded = BoardCore();
+        banded.resize(side, side);
+        mt19937 rng(seed);
+        start = chrono::steady_clock::now();
+        banded.placeMinesInBands(mines, rng, safeIndex, &pool);
+        double bandedMs = millisecondsSince(start);
+        bool same = hashState(banded) == expectedHash;
+        sameLayouts = sameLayouts && same;
+        cout << "  bands, " << setw(2) << threads << " threads: " << bandedMs << " ms (" << serialMs / bandedMs << "x serial)"
+             << (same ? "" : "  DIFFERENT LAYOUT") << endl;
+    }
+    checks.check("every thread count builds the same tiles", sameLayouts);
+
+    // Uniformity on small boards cut into many bands. With n candidates the statistic is about
+    // n - 1 (standard deviation about sqrt(2n)); the bound leaves six standard deviations
+    struct Uniformity {
+        const char* name;
+        int rows, columns, mines, safeIndex, bandRows;
+    };
+    const Uniformity tests[] = {{"8x6, 10 mines, 1-row bands", 6, 8, 10, -1, 1}, {"8x6, 10 mines, safe zone across 2-row bands", 6, 8, 10, 2 * 8 + 3, 2},
+                                {"5x7, 30 mines, 3-row bands (dense)", 7, 5, 30, -1, 3}};
+    cout << endl << "Mine frequency per tile over " << samples << " boards:" << endl;
+    for (const Uniformity& test : tests) {
+        int candidates = 0;
+        bool clear = true;
+        double chiSquare = mineFrequencyChiSquare(test.rows, test.columns, test.mines, test.safeIndex, test.bandRows, samples, candidates, clear);
+        double bound = candidates - 1 + 6 * sqrt(2.0 * candidates);
+        cout << "  " << left << setw(46) << test.name << right << "chi-square " << setprecision(1) << chiSquare << " over " << candidates
+             << " tiles (bound " << bound << ")" << endl;
+        checks.check(string("uniform mine placement: ") + test.name, chiSquare < bound && clear);
+    }
+
+    return checks.report();
+}
@@ -0,0 +1,139 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "../chunkedBoard.h"
+#include "benchCommon.h"
+using namespace std;
+
+// Endless board report: the cost of building chunks, and the memory of an exploration that goes
+// much farther than the resident-chunk cap. Also checks the endless board against its own hash:
+// the counts on chunk edges (built without their neighbors), flood fills that cross chunk
+// borders, and chunks that are evicted and rebuilt coming back with the player's marks.
+// Exits with an error if a check fails.
+//
+// Usage: endlessBench [chunks explored] [resident chunk cap] (defaults 2000 and 256)
+
+// Checks every tile of a chunk: mine bit and count as the hash says
+bool chunkMatchesHash(ChunkedBoard& board, int chunkColumn, int chunkRow) {
+    for (int i = 0; i < CHUNK_SIZE; i++) {
+        for (int j = 0; j < CHUNK_SIZE; j++) {
+            int column = chunkColumn * CHUNK_SIZE + j, row = chunkRow * CHUNK_SIZE + i;
+            uint8_t tile = board.tileAt(column, row);
+            bool mine = board.isMineAt(column, row);
+            if (((tile & TILE_MINE) != 0) != mine) return false;
+            if (!mine && (tile & TILE_COUNT_MASK) != board.nearbyMinesAt(column, row)) return false;
+        }
+    }
+    return true;
+}
+
+// Checks that no revealed empty tile in a rectangle has a hidden, unflagged neighbor
+bool floodFillComplete(ChunkedBoard& board, int left, int top, int width, int height) {
+    for (int i = top; i < top + height; i++) {
+        for (int j = left; j < left + width; j++) {
+            uint8_t tile = board.tileAt(j, i);
+            if (!(tile & TILE_REVEALED) || (tile & TILE_COUNT_MASK) != 0) continue;
+            for (int y = i - 1; y <= i + 1; y++) {
+                for (int x = j - 1; x <= j + 1; x++) {
+                    if (!(board.tileAt(x, y) & (TILE_REVEALED | TILE_FLAGGED))) return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    int explored = argc > 1 ? stoi(argv[1]) : 2000;
+    size_t cap = argc > 2 ? (size_t)stoul(argv[2]) : 256;
+    const double density = 99.0 / 480; // Expert density
+    BenchChecks checks(66, true);
+
+    // Building chunks as a viewport flies over new ground (no reveals, so nothing is archived)
+    {
+        ChunkedBoard board(7, density, cap);
+        const int chunks = 5000;
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < chunks; i++) board.tileAt(i * CHUNK_SIZE, -i * CHUNK_SIZE);
+        double buildMs = millisecondsSince(start);
+        cout << "Flying over " << chunks << " chunks: " << fixed << setprecision(1) << buildMs * 1000 / chunks << " us per chunk built, "
+             << board.residentChunks() << " resident, " << board.archivedChunks() << " archived, "
+             << setprecision(2) << board.memoryBytes() / 1048576.0 << " MB" << endl;
+        checks.check("unexplored chunks are dropped, not archived", board.archivedChunks() == 0 && board.residentChunks() <= cap);
+    }
+
+    cout << "Checks:" << endl;
+    {
+        // Counts on the edges of chunks in all four quadrants match the hash
+        ChunkedBoard board(11, density, cap);
+        bool edgesMatch = true;
+        const int chunkCoordinates[][2] = {{0, 0}, {-1, 0}, {0, -1}, {-1, -1}, {123, -456}, {-9999, 31}};
+        for (const auto& chunk : chunkCoordinates) edgesMatch = edgesMatch && chunkMatchesHash(board, chunk[0], chunk[1]);
+        checks.check("mines and edge counts match the hash", edgesMatch);
+
+        // The first reveal is safe and opens a region; a low density makes it cross many chunks
+        ChunkedBoard open(5, ENDLESS_MIN_DENSITY, cap);
+        open.toggleFlag(3, 3); // A flag placed before the first reveal survives the rebuild around the start
+        long long revealed = open.reveal(0, 0);
+        checks.check("first reveal is safe and keeps earlier flags", !open.loser && revealed > 0 && (open.tileAt(3, 3) & TILE_FLAGGED));
+        int firstChunkColumn = 0, lastChunkColumn = 0, firstChunkRow = 0, lastChunkRow = 0;
+        for (int i = -512; i < 512; i++) {
+            for (int j = -512; j < 512; j++) {
+                if (!(open.tileAt(j, i) & TILE_REVEALED)) continue;
+                firstChunkColumn = min(firstChunkColumn, ChunkedBoard::chunkOf(j));
+                lastChunkColumn = max(lastChunkColumn, ChunkedBoard::chunkOf(j));
+                firstChunkRow = min(firstChunkRow, ChunkedBoard::chunkOf(i));
+                lastChunkRow = max(lastChunkRow, ChunkedBoard::chunkOf(i));
+            }
+        }
+        int chunksSpanned = (lastChunkColumn - firstChunkColumn + 1) * (lastChunkRow - firstChunkRow + 1);
+        cout << "  first reveal at " << ENDLESS_MIN_DENSITY * 100 << "% mines opened " << revealed << " tiles over " << chunksSpanned << " chunks" << endl;
+        checks.check("flood fill crosses chunk borders and leaves no hidden edge", chunksSpanned > 1 && floodFillComplete(open, -512, -512, 1024, 1024));
+        checks.check("safe-tile counter matches the revealed tiles", open.revealedSafeTiles == revealed);
+    }
+
+    // Exploring a long strip: every safe tile of a band one chunk tall is revealed (the hash says
+    // which tiles are safe, so the game is never lost), far more chunks than the cap
+    ChunkedBoard board(2024, density, cap);
+    board.reveal(1, 1);
+    vector<uint8_t> firstChunk; // Snapshot of chunk (0, 0), which is evicted long before the end
+    for (int i = 0; i < CHUNK_TILES; i++) board.toggleFlag(i % 7 * 9, i / 7 % 60); // Some flags on chunk (0, 0)
+    auto start = chrono::steady_clock::now();
+    long long reveals = 0;
+    for (int chunk = 0; chunk < explored; chunk++) {
+        for (int i = 0; i < CHUNK_SIZE; i++) {
+            for (int j = 0; j < CHUNK_SIZE; j++) {
+                int column = chunk * CHUNK_SIZE + j;
+                if (board.isMineAt(column, i) || (board.tileAt(column, i) & (TILE_REVEALED | TILE_FLAGGED))) continue;
+                board.reveal(column, i);
+                reveals++;
+            }
+        }
+        if (chunk == 0) {
+            for (int i = 0; i < CHUNK_TILES; i++) firstChunk.push_back(board.tileAt(i % CHUNK_SIZE, i / CHUNK_SIZE));
+        }
+    }
+    double exploreMs = millisecondsSince(start);
+    size_t memoryAfter = board.memoryBytes();
+    double bytesPerExploredTile = (double)memoryAfter / ((double)explored * CHUNK_TILES);
+
+    cout << "Exploring " << explored << " chunks with a cap of " << cap << ": " << reveals << " reveals in " << setprecision(0) << exploreMs
+         << " ms, " << board.chunksBuilt << " chunks built, " << board.chunksEvicted << " evicted, " << board.residentChunks() << " resident, "
+         << board.archivedChunks() << " archived" << endl;
+    cout << "  memory " << setprecision(2) << memoryAfter / 1048576.0 << " MB (" << setprecision(3) << bytesPerExploredTile
+         << " B per explored tile; the resident chunks alone cost " << setprecision(2) << cap * (sizeof(BoardChunk) + 32) / 1048576.0 << " MB)" << endl;
+    cout << "Checks:" << endl;
+    checks.check("resident chunks stay under the cap", board.residentChunks() <= cap);
+    // The band's reveals spill into the chunk rows above and below it, so at most three chunks per
+    // column are explored; each explored chunk costs an archive of well under 1 KB
+    checks.check("memory grows with the explored area only", board.archivedChunks() <= (size_t)explored * 3 + 2 &&
+          memoryAfter <= cap * (sizeof(BoardChunk) + 32) + board.archivedChunks() * 1024);
+    bool sameAfterRebuild = true;
+    for (int i = 0; i < CHUNK_TILES; i++) sameAfterRebuild = sameAfterRebuild && board.tileAt(i % CHUNK_SIZE, i / CHUNK_SIZE) == firstChunk[i];
+    checks.check("an evicted chunk comes back with its mines, reveals and flags", sameAfterRebuild);
+    checks.check("flood fills over rebuilt chunks are complete", floodFillComplete(board, 0, 0, CHUNK_SIZE * min(explored, 8), CHUNK_SIZE));
+
+    return checks.report();
+}
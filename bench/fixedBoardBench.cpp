@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include "../fixedBoard.h"
+#include "benchCommon.h"
+using namespace std;
+
+// Compares the kernels compiled for the standard board sizes with the dynamic kernels on the same
+// boards: counting nearby mines, playing a whole game of reveals (every safe tile clicked in a
+// random order) and the revealed-safe-tile scan behind the debug win check. Checks that both give
+// exactly the same tiles, revealed in the same order, and that BoardCore::resize picks the
+// compiled kernels for the standard sizes only. Exits with an error if a check fails.
+//
+// Usage: fixedBoardBench [boards per size] (default 2000)
+
+// The BenchBoard struct is one starting layout and the order its safe tiles are clicked in.
+struct BenchBoard {
+    BoardCore layout;   // Mines placed and counted, nothing revealed.
+    vector<int> clicks; // Every safe tile, shuffled.
+};
+
+// Builds 'count' random boards of one size with the standard kernels picked by resize
+vector<BenchBoard> makeBoards(int rows, int columns, int mines, int count) {
+    vector<BenchBoard> boards(count);
+    mt19937 rng(rows * 1000 + columns);
+    for (BenchBoard& board : boards) {
+        board.layout.resize(rows, columns);
+        board.layout.placeMines(mines, rng, (int)(rng() % (rows * columns)));
+        for (int i = 0; i < rows * columns; i++) {
+            if (!board.layout.isMine(i)) board.clicks.push_back(i);
+        }
+        shuffle(board.clicks.begin(), board.clicks.end(), rng);
+    }
+    return boards;
+}
+
+// Plays every board to the end with the given kernels; returns the nanoseconds per game and
+// appends every revealed tile of every game to 'revealed' when it is not null
+double playGames(const vector<BenchBoard>& boards, const BoardKernels* kernels, vector<int>* revealed) {
+    BoardCore core = boards[0].layout;
+    core.kernels = kernels;
+    vector<int> revealedTiles;
+    revealedTiles.reserve(core.state.size());
+    double totalNs = 0;
+    for (const BenchBoard& board : boards) {
+        core.state = board.layout.state; // Same size, so no allocation
+        core.revealedSafeTiles = 0;
+        revealedTiles.clear();
+        auto start = chrono::steady_clock::now();
+        for (int click : board.clicks) {
+            if (!core.isRevealed(click)) core.reveal(click, revealedTiles);
+        }
+        totalNs += nanosecondsSince(start);
+        if (revealed) revealed->insert(revealed->end(), revealedTiles.begin(), revealedTiles.end());
+        if (core.revealedSafeTiles != (int)board.clicks.size()) return -1;
+    }
+    return totalNs / boards.size();
+}
+
+// Recounts the nearby mines of every board with the given kernels; returns the nanoseconds per board
+// and appends the resulting states to 'states' when it is not null
+double countBoards(const vector<BenchBoard>& boards, const BoardKernels* kernels, vector<uint8_t>* states) {
+    BoardCore core = boards[0].layout;
+    core.kernels = kernels;
+    double totalNs = 0;
+    for (const BenchBoard& board : boards) {
+        core.state = board.layout.state;
+        auto start = chrono::steady_clock::now();
+        core.countNearbyMines();
+        totalNs += nanosecondsSince(start);
+        if (states) states->insert(states->end(), core.state.begin(), core.state.end());
+    }
+    return totalNs / boards.size();
+}
+
+// Scans a half-played board many times with the given kernels; returns the nanoseconds per scan
+double scanBoard(const BenchBoard& board, const BoardKernels* kernels, int& result) {
+    BoardCore core = board.layout;
+    core.kernels = kernels;
+    vector<int> revealedTiles;
+    for (size_t i = 0; i < board.clicks.size() / 2; i++) core.reveal(board.clicks[i], revealedTiles);
+    const int scans = 20000;
+    int sink = 0;
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < scans; i++) sink += core.countRevealedSafeTiles(); // A call through a pointer, so it can't be hoisted
+    double scanNs = nanosecondsSince(start) / scans;
+    result = sink / scans;
+    return scanNs;
+}
+
+int main(int argc, char* argv[]) {
+    int boardCount = argc > 1 ? stoi(argv[1]) : 2000;
+    BenchChecks checks(60, true);
+
+    struct Size {
+        const char* name;
+        int rows, columns, mines;
+    };
+    const Size sizes[] = {{"beginner", 9, 9, 10}, {"intermediate", 16, 16, 40}, {"expert", 16, 30, 99}, {"default", 16, 25, 50}};
+
+    cout << left << setw(14) << "board" << setw(8) << "size" << right << setw(20) << "count mines (ns)" << setw(24) << "whole game (ns)"
+         << setw(20) << "win scan (ns)" << endl;
+    cout << setw(42) << "dynamic   fixed" << setw(24) << "dynamic     fixed" << setw(20) << "dynamic   fixed" << endl;
+    bool sameCounts = true, sameReveals = true, sameScans = true, picked = true;
+    for (const Size& size : sizes) {
+        vector<BenchBoard> boards = makeBoards(size.rows, size.columns, size.mines, boardCount);
+        const BoardKernels* compiled = boards[0].layout.kernels;
+        picked = picked && compiled != &DYNAMIC_BOARD_KERNELS && compiled->rows == size.rows && compiled->columns == size.columns;
+
+        // One untimed pass of each for the checks, then the timed passes
+        vector<uint8_t> dynamicStates, fixedStates;
+        countBoards(boards, &DYNAMIC_BOARD_KERNELS, &dynamicStates);
+        countBoards(boards, compiled, &fixedStates);
+        sameCounts = sameCounts && dynamicStates == fixedStates;
+        vector<int> dynamicRevealed, fixedRevealed;
+        bool dynamicWon = playGames(boards, &DYNAMIC_BOARD_KERNELS, &dynamicRevealed) >= 0;
+        bool fixedWon = playGames(boards, compiled, &fixedRevealed) >= 0;
+        sameReveals = sameReveals && dynamicWon && fixedWon && dynamicRevealed == fixedRevealed;
+
+        double countDynamicNs = countBoards(boards, &DYNAMIC_BOARD_KERNELS, nullptr);
+        double countFixedNs = countBoards(boards, compiled, nullptr);
+        double gameDynamicNs = playGames(boards, &DYNAMIC_BOARD_KERNELS, nullptr);
+        double gameFixedNs = playGames(boards, compiled, nullptr);
+        int dynamicScan = 0, fixedScan = 0;
+        double scanDynamicNs = scanBoard(boards[0], &DYNAMIC_BOARD_KERNELS, dynamicScan);
+        double scanFixedNs = scanBoard(boards[0], compiled, fixedScan);
+        sameScans = sameScans && dynamicScan == fixedScan;
+
+        cout << left << setw(14) << size.name << setw(8) << to_string(size.columns) + "x" + to_string(size.rows) << right << fixed << setprecision(0)
+             << setw(12) << countDynamicNs << setw(8) << countFixedNs << setw(14) << gameDynamicNs << setw(10) << gameFixedNs
+             << setw(12) << setprecision(1) << scanDynamicNs << setw(8) << scanFixedNs << endl;
+    }
+
+    cout << "Checks:" << endl;
+    checks.check("resize picks the compiled kernels for the standard sizes", picked);
+    BoardCore other;
+    other.resize(30, 16); // Expert turned on its side is not a compiled size
+    BoardCore custom;
+    custom.resize(20, 20);
+    checks.check("other sizes use the dynamic kernels", other.kernels == &DYNAMIC_BOARD_KERNELS && custom.kernels == &DYNAMIC_BOARD_KERNELS);
+    checks.check("nearby mine counts match the dynamic kernels", sameCounts);
+    checks.check("whole games reveal the same tiles in the same order", sameReveals);
+    checks.check("revealed-safe-tile scans match the dynamic kernels", sameScans);
+
+    return checks.report();
+}
@@ -0,0 +1,47 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "../gameEngine.h"
+#include "../workStealingPool.h"
+using namespace std;
+
+// Times the no-guess generator for each difficulty: how many candidate layouts the parallel
+// search tests before one passes, and the wall time of the whole search (first click in the
+// centre). A dense board where no candidate passes shows the first reveal falling back to a random
+// layout at the time limit the engine gives the search (NO_GUESS_BUDGET_MILLISECONDS).
+
+// Runs 'runs' searches with different seeds and prints the median and worst attempts and times
+void runCase(const string& name, const BoardConfig& config, int runs, double maxMilliseconds = NO_GUESS_BUDGET_MILLISECONDS) {
+    int safeIndex = (config.rows / 2) * config.columns + config.columns / 2;
+    vector<double> times;
+    vector<int> attempts;
+    int failures = 0;
+
+    for (int run = 0; run < runs; run++) {
+        uint32_t layoutSeed;
+        GenerationReport report;
+        findNoGuessLayout(config.rows, config.columns, config.mineCount, safeIndex, 7000 + run, layoutSeed, &report, 100000, maxMilliseconds);
+        if (!report.found) failures++;
+        times.push_back(report.milliseconds);
+        attempts.push_back(report.attempts);
+    }
+    sort(times.begin(), times.end());
+    sort(attempts.begin(), attempts.end());
+
+    cout << left << setw(14) << name << setw(14) << to_string(config.columns) + "x" + to_string(config.rows) + "/" + to_string(config.mineCount)
+         << setw(16) << attempts[runs / 2] << setw(14) << attempts.back() << fixed << setprecision(2) << setw(14) << times[runs / 2]
+         << setw(14) << times.back() << failures << endl;
+}
+
+int main() {
+    cout << "Pool threads: " << WorkStealingPool::shared().size() << endl;
+    cout << left << setw(14) << "difficulty" << setw(14) << "board" << setw(16) << "median attempts" << setw(14) << "max attempts"
+         << setw(14) << "median (ms)" << setw(14) << "max (ms)" << "failed" << endl;
+    runCase("beginner", BoardConfig{9, 9, 10}, 200);
+    runCase("intermediate", BoardConfig{16, 16, 40}, 200);
+    runCase("expert", BoardConfig{30, 16, 99}, 50);
+    runCase("dense", BoardConfig{30, 16, 170}, 5); // No layout passes: every search runs to the time limit
+    return 0;
+}
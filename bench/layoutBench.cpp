@@ -0,0 +1,124 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include "../boardCore.h"
+#include "benchCommon.h"
+#include <SFML/Graphics.hpp>
+using namespace std;
+using namespace sf;
+
+// Compares the flat BoardCore layout with the old layout of one heap-allocated Tile per
+// square (12 textures, a sprite, a neighbor vector and separate flags), reporting memory
+// per tile and the time of the full-board walks that reveal and the win check perform.
+// Usage: layoutBench [columns rows]
+
+// Copy of the old Tile members, so the old layout can be measured without loading images
+struct LegacyTile {
+    Texture textures[12];              // The 12 per-tile textures the old Tile carried
+    Sprite sprite;                     // Sprite representing the tile
+    vector<LegacyTile*> neighbors;     // Pointers to up to 8 neighboring tiles
+    bool tile_mine = false;
+    bool tile_flagged = false;
+    bool tile_enabled = true;
+    bool tile_revealed = false;
+    int nearbyMines = 0;
+};
+
+int main(int argc, char* argv[]) {
+    int columns = argc > 2 ? stoi(argv[1]) : 512;
+    int rows = argc > 2 ? stoi(argv[2]) : 512;
+    const int passes = 20; // Each walk is repeated and averaged
+
+    // Build the flat board with 15% mines and about half of the safe tiles revealed
+    mt19937 rng(1);
+    BoardCore core;
+    core.resize(rows, columns);
+    for (int i = 0; i < (int)core.state.size(); i++) {
+        if (rng() % 100 < 15) core.setMine(i);
+        else if (rng() % 2) core.state[i] |= TILE_REVEALED;
+    }
+    core.countNearbyMines();
+
+    // Build the same board in the old layout
+    vector<vector<LegacyTile*>*> legacy;
+    for (int i = 0; i < rows; i++) {
+        vector<LegacyTile*>* currRow = new vector<LegacyTile*>;
+        for (int j = 0; j < columns; j++) {
+            LegacyTile* tile = new LegacyTile;
+            tile->tile_mine = core.isMine(core.index(i, j));
+            tile->tile_revealed = core.isRevealed(core.index(i, j));
+            currRow->push_back(tile);
+        }
+        legacy.push_back(currRow);
+    }
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < columns; j++) {
+            core.forEachNeighbor(core.index(i, j), [&](int neighbor) {
+                legacy[i]->at(j)->neighbors.push_back(legacy[neighbor / columns]->at(neighbor % columns));
+            });
+        }
+    }
+
+    // Memory per tile: the old layout pays for the Tile object, its neighbor vector buffer,
+    // a heap header for each of those two allocations and a share of its row vector
+    const double heapHeader = 16;
+    double legacyBytes = 0;
+    for (int i = 0; i < rows; i++) {
+        for (LegacyTile* tile : *legacy[i]) {
+            legacyBytes += sizeof(LegacyTile) + heapHeader + tile->neighbors.capacity() * sizeof(LegacyTile*) + heapHeader;
+        }
+        legacyBytes += sizeof(vector<LegacyTile*>) + heapHeader + legacy[i]->capacity() * sizeof(LegacyTile*) + heapHeader;
+    }
+    double tileCount = (double)rows * columns;
+    cout << "board " << columns << "x" << rows << " (" << (long long)tileCount << " tiles)" << endl;
+    cout << fixed << setprecision(1);
+    cout << "bytes per tile: old layout " << legacyBytes / tileCount << ", flat layout " << (double)core.state.size() / tileCount << endl;
+
+    // Walk 1: count revealed safe tiles (what checkIfWinner does)
+    long long checksum = 0;
+    auto start = chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; pass++) {
+        for (int i = 0; i < rows; i++) {
+            for (LegacyTile* tile : *legacy[i]) {
+                if (!tile->tile_mine && tile->tile_revealed) checksum++;
+            }
+        }
+    }
+    double legacyScanMs = millisecondsSince(start) / passes;
+
+    start = chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; pass++) checksum -= core.countRevealedSafeTiles();
+    double flatScanMs = millisecondsSince(start) / passes;
+
+    // Walk 2: count the mines around every tile (what the constructor does)
+    start = chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; pass++) {
+        for (int i = 0; i < rows; i++) {
+            for (LegacyTile* tile : *legacy[i]) {
+                int count = 0;
+                for (LegacyTile* neighbor : tile->neighbors) {
+                    if (neighbor->tile_mine) count++;
+                }
+                tile->nearbyMines = count;
+            }
+        }
+    }
+    double legacyNeighborMs = millisecondsSince(start) / passes;
+
+    start = chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; pass++) core.countNearbyMines();
+    double flatNeighborMs = millisecondsSince(start) / passes;
+
+    cout << setprecision(3);
+    cout << "revealed-safe scan: old layout " << legacyScanMs << " ms, flat layout " << flatScanMs << " ms" << endl;
+    cout << "neighbor mine count: old layout " << legacyNeighborMs << " ms, flat layout " << flatNeighborMs << " ms" << endl;
+    if (checksum != 0) cout << "warning: layouts disagree on the revealed tile count" << endl;
+
+    for (vector<LegacyTile*>* currRow : legacy) {
+        for (LegacyTile* tile : *currRow) delete tile;
+        delete currRow;
+    }
+    return 0;
+}
@@ -0,0 +1,137 @@
+#include <iostream>
+#include <algorithm>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "../leaderboard.h"
+#include "benchCommon.h"
+using namespace std;
+
+// Loads and updates a leaderboard file of one million wins with the indexed store, and with a
+// replica of the old code (stringstream parse of every line, then a linear-scan insert and a
+// full rewrite of the file on every win) for comparison. Uses scratch files in the working
+// directory and removes them at the end.
+
+const int HISTORY_SIZE = 1000000;
+const string DIFFICULTY = "30x16x99";
+
+// Formats a time as MM:SS
+string formatTime(int seconds) {
+    int minutes = seconds / 60;
+    int remainder = seconds % 60;
+    return (minutes < 10 ? "0" : "") + to_string(minutes) + ":" + (remainder < 10 ? "0" : "") + to_string(remainder);
+}
+
+// Writes 'count' wins sorted by time, in the old "MM:SS,Name" format or the tagged store format
+void writeHistory(const string& path, int count, bool tagged) {
+    mt19937 rng(42);
+    vector<int> times(count);
+    for (int& time : times) time = 30 + rng() % 3600;
+    sort(times.begin(), times.end());
+
+    ofstream file(path, ios::trunc);
+    for (int i = 0; i < count; i++) {
+        file << formatTime(times[i]) << ",Player" << (i % 1000);
+        if (tagged) file << "," << DIFFICULTY;
+        file << "\n";
+    }
+}
+
+// The old leaderboard entry, with its 'short' time
+struct Player {
+    short secondsTime;
+    string name;
+};
+
+// Old load: stringstream and stoi on every line
+vector<Player> legacyLoad(const string& path) {
+    vector<Player> players;
+    ifstream file(path);
+    string line;
+    while (getline(file, line)) {
+        Player player;
+        stringstream ss(line);
+        string minutes, seconds;
+        getline(ss, minutes, ':');
+        getline(ss, seconds, ',');
+        player.secondsTime = stoi(seconds) + stoi(minutes) * 60;
+        getline(ss, player.name);
+        players.push_back(player);
+    }
+    return players;
+}
+
+// Old win: linear scan to the insert position, then truncate and rewrite the whole file
+void legacyAddScore(const string& path, vector<Player>& players, Player player) {
+    auto iter = players.begin();
+    while (iter != players.end() && iter->secondsTime <= player.secondsTime) iter++;
+    players.insert(iter, player);
+
+    ofstream file(path, ios::trunc);
+    for (const Player& entry : players) file << formatTime(entry.secondsTime) << "," << entry.name << "\n";
+}
+
+int main() {
+    const string legacyPath = "leaderboardBench_legacy.txt";
+    const string storePath = "leaderboardBench_store.txt";
+    writeHistory(legacyPath, HISTORY_SIZE, false);
+    writeHistory(storePath, HISTORY_SIZE, true);
+    cout << fixed << setprecision(3);
+
+    // Old code: load, then three wins
+    auto start = chrono::steady_clock::now();
+    vector<Player> players = legacyLoad(legacyPath);
+    double legacyLoadMs = millisecondsSince(start);
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < 3; i++) legacyAddScore(legacyPath, players, Player{(short)(600 + i), "Legacy"});
+    double legacyWinMs = millisecondsSince(start) / 3;
+
+    // Store: load of a compacted file
+    start = chrono::steady_clock::now();
+    LeaderboardStore* store = new LeaderboardStore(storePath, DIFFICULTY);
+    double loadMs = millisecondsSince(start);
+
+    // Store: wins (appends, and the compactions they trigger)
+    const int winCount = 20000;
+    mt19937 rng(7);
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < winCount; i++) store->addScore(DIFFICULTY, 30 + rng() % 3600, "Newplayer");
+    double winUs = millisecondsSince(start) * 1000 / winCount;
+
+    // Store: top five queries
+    const int queryCount = 100000;
+    size_t checksum = 0;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < queryCount; i++) checksum += store->board(DIFFICULTY).top(5).size();
+    double queryUs = millisecondsSince(start) * 1000 / queryCount;
+
+    // Store: load with an unsorted tail, then an explicit compaction
+    for (int i = 0; i < 1000; i++) store->addScore(DIFFICULTY, 30 + rng() % 3600, "Tail");
+    delete store;
+    start = chrono::steady_clock::now();
+    store = new LeaderboardStore(storePath, DIFFICULTY);
+    double tailLoadMs = millisecondsSince(start);
+    start = chrono::steady_clock::now();
+    store->compact();
+    double compactMs = millisecondsSince(start);
+    size_t finalSize = store->board(DIFFICULTY).size();
+    delete store;
+
+    cout << "History: " << HISTORY_SIZE << " wins (" << finalSize << " after the benchmark)" << endl;
+    cout << "Old load:                  " << legacyLoadMs << " ms" << endl;
+    cout << "Old win (insert+rewrite):  " << legacyWinMs << " ms" << endl;
+    cout << "Store load (compacted):    " << loadMs << " ms" << endl;
+    cout << "Store load (unsorted tail): " << tailLoadMs << " ms" << endl;
+    cout << "Store win (append):        " << winUs << " us (mean over " << winCount << " wins; no compaction was due)" << endl;
+    cout << "Store top-5 query:         " << queryUs << " us" << endl;
+    cout << "Store compaction:          " << compactMs << " ms" << endl;
+
+    remove(legacyPath.c_str());
+    remove(storePath.c_str());
+    return checksum == 0;
+}
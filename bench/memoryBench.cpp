@@ -0,0 +1,81 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "../gameEngine.h"
+#include "benchCommon.h"
+#ifdef _WIN32
+#define PSAPI_VERSION 2 // GetProcessMemoryInfo from kernel32, no extra library
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+using namespace std;
+
+// Memory report for large and huge boards: builds boards of increasing size with the expert
+// mine density (about 20.6%), makes the first reveal in the centre (which places the mines and
+// counts the nearby mines), and reports the build and first-reveal times, the bytes of tile
+// storage per tile and the peak resident set size of the process. Sizes are measured from the
+// smallest to the largest and each board is freed before the next one, so the peak reported
+// for a size is the peak that size needed. Boards from HUGE_BOARD_TILES tiles up use the
+// in-place mine placement. Checks that every board gets exactly its mine count and a safe
+// first click, and exits with an error if not.
+//
+// Usage: memoryBench [largest side] (default 10000, i.e. up to a 10000x10000 board)
+
+// Returns the peak resident set size of the process in bytes
+double peakResidentBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return (double)counters.PeakWorkingSetSize;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss * 1024.0; // Kilobytes on Linux
+#endif
+}
+
+int main(int argc, char* argv[]) {
+    int largestSide = argc > 1 ? stoi(argv[1]) : 10000;
+    const int sides[] = {500, 1000, 2000, 3000, 5000, 7000, 10000};
+    double baseline = peakResidentBytes();
+    bool allPassed = true;
+
+    cout << "Tiles from " << HUGE_BOARD_TILES << " up are huge boards; baseline peak RSS " << fixed << setprecision(1)
+         << baseline / 1048576 << " MB" << endl;
+    cout << left << setw(13) << "board" << setw(13) << "tiles" << setw(8) << "huge" << setw(12) << "build (ms)" << setw(14)
+         << "reveal (ms)" << setw(14) << "state B/tile" << setw(15) << "peak RSS (MB)" << setw(16) << "peak B/tile" << "check" << endl;
+    for (int side : sides) {
+        if (side > largestSide) break;
+        {
+            BoardConfig config{side, side, (int)((long long)side * side * 99 / 480)};
+
+            auto start = chrono::steady_clock::now();
+            GameEngine engine(config, 2024);
+            double buildMs = millisecondsSince(start);
+
+            start = chrono::steady_clock::now();
+            vector<int> revealedTiles;
+            int firstClick = engine.core.index(side / 2, side / 2);
+            engine.reveal(firstClick, revealedTiles);
+            double revealMs = millisecondsSince(start);
+
+            // Exactly the requested mines, and the first click is never a mine
+            long long mines = 0;
+            for (uint8_t tile : engine.core.state) mines += (tile & TILE_MINE) != 0;
+            bool passed = mines == engine.mineCount && !engine.loser && engine.core.isRevealed(firstClick);
+            allPassed = allPassed && passed;
+
+            double peak = peakResidentBytes();
+            cout << setw(13) << (to_string(side) + "x" + to_string(side)) << setw(13) << engine.tiles << setw(8)
+                 << (engine.tiles >= HUGE_BOARD_TILES ? "yes" : "no") << setprecision(1) << setw(12) << buildMs << setw(14)
+                 << revealMs << setprecision(2) << setw(14) << (double)engine.core.state.capacity() / engine.tiles
+                 << setprecision(1) << setw(15) << peak / 1048576 << setprecision(2) << setw(16)
+                 << (peak - baseline) / engine.tiles << (passed ? "ok" : "FAILED") << endl;
+        } // The board is freed here, before the next size
+    }
+    return allPassed ? 0 : 1;
+}
@@ -0,0 +1,52 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include "../boardCore.h"
+#include "benchCommon.h"
+using namespace std;
+
+// Sweeps mine density from 1% to 99% on a 1000x1000 board and times mine placement:
+// the old rejection sampling (pick a random tile, retry if it already has a mine) versus
+// BoardCore::placeMines, which shuffles the candidate tiles once.
+
+int main() {
+    const int side = 1000;
+    const int densities[] = {1, 5, 10, 25, 50, 75, 90, 95, 99};
+    mt19937 rng(11);
+
+    cout << left << setw(10) << "density" << setw(12) << "mines" << setw(18) << "rejection (ms)" << setw(16) << "retries"
+         << "placeMines (ms)" << endl;
+    for (int density : densities) {
+        int mineCount = (int)((long long)side * side * density / 100);
+
+        // Old approach: draw a row and column, retry when the tile already holds a mine
+        BoardCore old;
+        old.resize(side, side);
+        long long retries = 0;
+        auto start = chrono::steady_clock::now();
+        uniform_int_distribution<int> pickRow(0, side - 1), pickColumn(0, side - 1);
+        for (int i = 0; i < mineCount; i++) {
+            int index = old.index(pickRow(rng), pickColumn(rng));
+            if (old.isMine(index)) {
+                i--;
+                retries++;
+            } else {
+                old.setMine(index);
+            }
+        }
+        old.countNearbyMines();
+        double rejectionMs = millisecondsSince(start);
+
+        // New approach, with the first click in the middle of the board kept safe
+        BoardCore core;
+        core.resize(side, side);
+        start = chrono::steady_clock::now();
+        core.placeMines(mineCount, rng, core.index(side / 2, side / 2));
+        double placeMs = millisecondsSince(start);
+
+        cout << left << setw(10) << to_string(density) + "%" << setw(12) << mineCount << setw(18) << fixed << setprecision(2)
+             << rejectionMs << setw(16) << retries << placeMs << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../gameEngine.h"
+#include "benchCommon.h"
+using namespace std;
+
+// Times restarting a game on boards from expert size to 100 million tiles three ways: building a
+// new engine and copying it over the old one (what the face button used to do), resetting the
+// tiles in place (GameEngine::restart), and swapping in a board reset ahead of time by a
+// BoardQueue. Between restarts the game is played a little (some flags and revealed tiles), and
+// the queue is given time to top itself up, as it is while a player plays. Reports the median and
+// p99 stall per restart. Checks that every path gives exactly the game a new engine with the same
+// seed gives (tiles, counters and random stream), that the same clicks play out the same after a
+// restart, and that the in-place and queued restarts reuse the tile storage instead of
+// allocating it. Exits with an error if a check fails.
+//
+// Usage: restartBench [largest side] (default 10000)
+
+// Flags and reveals a scattered set of tiles without placing mines, so every restart has tiles to undo
+void playALittle(GameEngine& game) {
+    for (int i = 0; i < game.tiles; i += 97) {
+        if (i % 2) game.toggleFlag(i);
+        else game.core.state[i] |= TILE_REVEALED;
+    }
+}
+
+// Returns whether two engines hold the same game (see benchCommon.h) from the same seed, with the
+// same kernels and the same random stream ahead
+bool sameGameAndStream(const GameEngine& a, const GameEngine& b) {
+    mt19937 aRng = a.rng, bRng = b.rng;
+    bool sameStream = true;
+    for (int i = 0; i < 8; i++) sameStream = sameStream && aRng() == bRng();
+    return sameGame(a, b) && a.tiles == b.tiles && a.seed == b.seed && a.core.kernels == b.core.kernels && sameStream;
+}
+
+int main(int argc, char* argv[]) {
+    int largestSide = argc > 1 ? stoi(argv[1]) : 10000;
+    vector<BoardConfig> configs = {{30, 16, 99}, {1000, 1000, 206250}};
+    for (int side : {4000, 10000}) {
+        if (side <= largestSide) configs.push_back({side, side, (int)((long long)side * side * 99 / 480)});
+    }
+
+    BenchChecks checks(68);
+
+    cout << left << setw(14) << "board" << setw(12) << "tiles" << setw(22) << "restart" << right << setw(14) << "median (us)" << setw(12)
+         << "p99 (us)" << endl;
+    bool sameAsNew = true, inPlaceReused = true, queueReused = true;
+    for (const BoardConfig& config : configs) {
+        long long tiles = (long long)config.columns * config.rows;
+        int restarts = (int)min(1000LL, max(10LL, 200000000LL / tiles));
+        int spareBoards = tiles >= HUGE_BOARD_TILES ? 1 : 2; // As main.cpp keeps them
+        string boardName = to_string(config.columns) + "x" + to_string(config.rows);
+
+        for (int path = 0; path < 3; path++) {
+            const char* pathName[] = {"new board + copy", "reset in place", "board queue"};
+            GameEngine game(config, 1);
+            BoardQueue queue(config.rows, config.columns, path == 2 ? spareBoards : 0);
+            const uint8_t* firstStorage = game.core.state.data();
+            set<const uint8_t*> storages;
+            vector<double> times;
+            uint32_t seed = 1;
+            for (int r = 0; r < restarts; r++) {
+                playALittle(game);
+                while (path == 2 && queue.readyCount() < (size_t)spareBoards) this_thread::sleep_for(chrono::microseconds(200)); // The player's game time
+                seed = streamSeed(42, r);
+                auto start = chrono::steady_clock::now();
+                if (path == 0) {
+                    GameEngine fresh(config, seed);
+                    game = fresh;
+                } else {
+                    game.restart(config, seed, path == 2 ? &queue : nullptr);
+                }
+                times.push_back(microsecondsSince(start));
+                if (path == 1) inPlaceReused = inPlaceReused && game.core.state.data() == firstStorage;
+                if (path == 2 && r >= spareBoards) storages.insert(game.core.state.data()); // After the queue's first boards are used
+            }
+            if (path == 2) queueReused = queueReused && storages.size() <= (size_t)spareBoards + 1;
+            sameAsNew = sameAsNew && sameGameAndStream(game, GameEngine(config, seed));
+
+            sort(times.begin(), times.end());
+            cout << left << setw(14) << boardName << setw(12) << tiles << setw(22) << pathName[path] << right << fixed << setprecision(1) << setw(14)
+                 << percentile(times, 50) << setw(12) << percentile(times, 99) << endl;
+        }
+    }
+
+    // The same clicks play out the same after a restart as on a new engine with the same seed
+    BoardConfig expert = {30, 16, 99};
+    GameEngine replayed(expert, 7);
+    BoardQueue queue(expert.rows, expert.columns);
+    bool sameGames = true;
+    for (int g = 0; g < 50; g++) {
+        uint32_t seed = streamSeed(7, g);
+        GameEngine fresh(expert, seed);
+        while (queue.readyCount() < 2) this_thread::sleep_for(chrono::microseconds(200));
+        replayed.restart(expert, seed, g % 2 ? &queue : nullptr);
+        vector<int> freshTiles, replayedTiles;
+        for (int click : {7 * 30 + 15, 0, 479, 200, 333, 31}) {
+            fresh.reveal(click, freshTiles);
+            replayed.reveal(click, replayedTiles);
+        }
+        sameGames = sameGames && freshTiles == replayedTiles && sameGameAndStream(fresh, replayed);
+    }
+
+    checks.check("every restart gives the game a new engine with the same seed gives", sameAsNew);
+    checks.check("the same clicks play out the same after a restart", sameGames);
+    checks.check("in-place restarts keep the same tile storage", inPlaceReused);
+    checks.check("queued restarts cycle through the same few tile buffers", queueReused);
+    return checks.report();
+}
@@ -0,0 +1,43 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include "../boardCore.h"
+#include "benchCommon.h"
+using namespace std;
+
+// Times worst-case reveals with the worklist flood fill: a board with no mines (one click
+// reveals everything) and a serpentine maze of mine walls (one click walks the whole maze),
+// at about 1 thousand, 100 thousand and 10 million tiles.
+
+// Reveals from the top-left corner and prints the time and the number of tiles revealed
+void runCase(const string& name, int side, bool maze) {
+    BoardCore core;
+    core.resize(side, side);
+    if (maze) buildMaze(core);
+    core.countNearbyMines();
+
+    vector<int> revealedTiles;
+    auto start = chrono::steady_clock::now();
+    core.reveal(core.index(1, 1), revealedTiles);
+    double revealMs = millisecondsSince(start);
+
+    long long tileCount = (long long)side * side;
+    cout << left << setw(8) << name << setw(14) << to_string(side) + "x" + to_string(side) << setw(12) << tileCount
+         << setw(12) << revealedTiles.size() << setw(12) << fixed << setprecision(3) << revealMs
+         << setprecision(1) << revealedTiles.size() / (revealMs * 1000.0) << endl;
+}
+
+int main() {
+    const long long sizes[] = {1000, 100000, 10000000}; // Approximate tile counts
+
+    cout << left << setw(8) << "board" << setw(14) << "size" << setw(12) << "tiles" << setw(12) << "revealed"
+         << setw(12) << "time (ms)" << "Mtiles/s" << endl;
+    for (long long tiles : sizes) {
+        int side = (int)sqrt((double)tiles);
+        runCase("empty", side, false);
+        runCase("maze", side, true);
+    }
+    return 0;
+}
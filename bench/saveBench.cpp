@@ -0,0 +1,102 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "../saveGame.h"
+#include "benchCommon.h"
+using namespace std;
+
+// Saves and loads games in progress at several board sizes, reporting the file size, bits per
+// tile and the save and load times. Every load is checked against the original game (round
+// trip), and truncated or foreign files must be rejected; the program exits with an error if
+// any check fails. Uses a scratch file in the working directory and removes it at the end.
+
+const string SAVE_PATH = "saveBench_game.bin";
+
+// Plays part of a game: the first click, some random reveals of safe tiles and some flags
+GameEngine buildGameInProgress(int columns, int rows, int mines, uint32_t seed) {
+    GameEngine engine(BoardConfig{columns, rows, mines}, seed);
+    mt19937 rng(seed);
+    vector<int> revealedTiles;
+    engine.reveal(engine.core.index(rows / 2, columns / 2), revealedTiles);
+    for (int i = 0; i < engine.tiles / 50 && !engine.loser && !engine.winner; i++) {
+        int index = rng() % engine.tiles;
+        if (engine.core.isMine(index)) engine.toggleFlag(index);
+        else engine.reveal(index, revealedTiles);
+    }
+    return engine;
+}
+
+// Rewrites the scratch file with only its first 'bytes' bytes
+void truncateSave(long bytes) {
+    FILE* file = fopen(SAVE_PATH.c_str(), "rb");
+    vector<char> data(bytes);
+    size_t got = fread(data.data(), 1, bytes, file);
+    fclose(file);
+    file = fopen(SAVE_PATH.c_str(), "wb");
+    fwrite(data.data(), 1, got, file);
+    fclose(file);
+}
+
+// Runs the round trip for one board size; returns false if a check failed
+bool runCase(int columns, int rows, int mines) {
+    GameEngine original = buildGameInProgress(columns, rows, mines, 99);
+    const string name = "Tester";
+    const int64_t elapsed = 123456789;
+
+    auto start = chrono::steady_clock::now();
+    bool saved = saveGame(SAVE_PATH, original, name, elapsed);
+    double saveMs = millisecondsSince(start);
+
+    FILE* file = fopen(SAVE_PATH.c_str(), "rb");
+    fseek(file, 0, SEEK_END);
+    long fileSize = ftell(file);
+    fclose(file);
+
+    GameEngine loaded(BoardConfig{9, 9, 10}, 1);
+    string loadedName;
+    int64_t loadedElapsed = 0;
+    start = chrono::steady_clock::now();
+    bool read = loadGame(SAVE_PATH, loaded, loadedName, loadedElapsed);
+    double loadMs = millisecondsSince(start);
+
+    bool roundTrip = saved && read && sameGame(original, loaded) && loadedName == name && loadedElapsed == elapsed;
+
+    // A truncated file must be rejected without touching the engine
+    truncateSave(fileSize - 1);
+    GameEngine untouched(BoardConfig{9, 9, 10}, 1);
+    bool rejected = !loadGame(SAVE_PATH, untouched, loadedName, loadedElapsed) && untouched.rows == 9;
+
+    long long tiles = (long long)columns * rows;
+    cout << left << setw(14) << to_string(columns) + "x" + to_string(rows) << setw(12) << tiles << setw(12) << fileSize
+         << setw(12) << fixed << setprecision(2) << fileSize * 8.0 / tiles << setw(12) << setprecision(3) << saveMs
+         << setw(12) << loadMs << (roundTrip && rejected ? "ok" : "FAILED") << endl;
+    return roundTrip && rejected;
+}
+
+int main() {
+    cout << left << setw(14) << "board" << setw(12) << "tiles" << setw(12) << "bytes" << setw(12) << "bits/tile"
+         << setw(12) << "save (ms)" << setw(12) << "load (ms)" << "round trip" << endl;
+    bool ok = runCase(30, 16, 99);
+    ok = runCase(31, 17, 100) && ok; // Odd tile count (last byte half used)
+    ok = runCase(1000, 1000, 206250) && ok;
+    ok = runCase(4000, 4000, 3300000) && ok;
+
+    // A file that is not a save must be rejected
+    FILE* file = fopen(SAVE_PATH.c_str(), "wb");
+    fputs("not a save file, just some text that is long enough for a header", file);
+    fclose(file);
+    GameEngine engine(BoardConfig{9, 9, 10}, 1);
+    string name;
+    int64_t elapsed;
+    if (loadGame(SAVE_PATH, engine, name, elapsed)) {
+        cout << "Foreign file was accepted" << endl;
+        ok = false;
+    }
+
+    remove(SAVE_PATH.c_str());
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,122 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include "../gameEngine.h"
+#include "../solver.h"
+#include "benchCommon.h"
+using namespace std;
+
+// Times the incremental solver move by move: each game starts from the centre tile, then plays
+// the solver's safe tiles and proven mines; when nothing is provable it guesses a random hidden
+// safe tile (so games always run to the end). Reports the solve latency per move on the expert
+// board (30x16, 99 mines) and on a 1000x1000 board at the same density.
+// Then checks that random player flags, many of them wrong, never lead the solver to a wrong
+// conclusion (a proven safe tile that is a mine, or a proven mine that is not). Exits with an
+// error if the check fails.
+
+// Plays one game and appends the solve time of every move to 'samples'
+void playGame(const BoardConfig& config, uint32_t seed, vector<double>& samples, long long& guesses) {
+    GameEngine engine(config, seed);
+    Solver solver;
+    mt19937 guessRng(seed ^ 0x9e3779b9u);
+    vector<int> revealedTiles;
+
+    engine.reveal(engine.core.index(engine.rows / 2, engine.columns / 2), revealedTiles);
+    solver.tilesRevealed(engine.core, revealedTiles);
+
+    while (!engine.winner && !engine.loser) {
+        auto start = chrono::steady_clock::now();
+        solver.solve(engine.core);
+        int safeTile = solver.nextSafeTile(engine.core);
+        int mineTile = safeTile < 0 ? solver.nextMineTile(engine.core) : -1;
+        samples.push_back(microsecondsSince(start));
+
+        if (safeTile >= 0) {
+            revealedTiles.clear();
+            engine.reveal(safeTile, revealedTiles);
+            solver.tilesRevealed(engine.core, revealedTiles);
+        } else if (mineTile >= 0) {
+            engine.toggleFlag(mineTile);
+            solver.flagToggled(engine.core, mineTile);
+        } else {
+            // Forced guess: pick a random hidden safe tile so the game keeps going
+            vector<int> candidates;
+            for (int i = 0; i < engine.tiles; i++) {
+                if (!engine.core.isRevealed(i) && !engine.core.isMine(i)) candidates.push_back(i);
+            }
+            int guess = candidates[guessRng() % candidates.size()];
+            revealedTiles.clear();
+            engine.reveal(guess, revealedTiles);
+            solver.tilesRevealed(engine.core, revealedTiles);
+            guesses++;
+        }
+    }
+}
+
+// Plays 'games' games on one board size and prints the latency summary
+void runCase(const string& name, const BoardConfig& config, int games) {
+    vector<double> samples;
+    long long guesses = 0;
+    for (int g = 0; g < games; g++) playGame(config, 1000 + g, samples, guesses);
+
+    sort(samples.begin(), samples.end());
+    double total = 0;
+    for (double sample : samples) total += sample;
+    double median = samples[samples.size() / 2];
+    double p99 = samples[min(samples.size() - 1, samples.size() * 99 / 100)];
+
+    cout << left << setw(10) << name << setw(14) << to_string(config.columns) + "x" + to_string(config.rows)
+         << setw(8) << games << setw(12) << samples.size() << setw(10) << guesses << fixed << setprecision(2)
+         << setw(14) << median << setw(14) << p99 << total / samples.size() << endl;
+}
+
+// Plays 'games' expert games by the solver's proofs while flagging random hidden tiles in between;
+// returns the number of proofs that were wrong
+int countWrongProofs(int games) {
+    int wrong = 0;
+    for (int g = 0; g < games; g++) {
+        GameEngine engine(BoardConfig{30, 16, 99}, 5000 + g);
+        Solver solver;
+        mt19937 flagRng(g);
+        vector<int> revealedTiles;
+        engine.reveal(engine.core.index(engine.rows / 2, engine.columns / 2), revealedTiles);
+        solver.tilesRevealed(engine.core, revealedTiles);
+        while (!engine.winner && !engine.loser) {
+            int flagTile = flagRng() % engine.tiles;
+            if (flagRng() % 3 == 0 && engine.toggleFlag(flagTile)) solver.flagToggled(engine.core, flagTile);
+
+            solver.solve(engine.core);
+            int safeTile = solver.nextSafeTile(engine.core);
+            int mineTile = safeTile < 0 ? solver.nextMineTile(engine.core) : -1;
+            if (safeTile >= 0) {
+                if (engine.core.isMine(safeTile)) wrong++;
+                revealedTiles.clear();
+                engine.reveal(safeTile, revealedTiles);
+                solver.tilesRevealed(engine.core, revealedTiles);
+            } else if (mineTile >= 0) {
+                if (!engine.core.isMine(mineTile)) wrong++;
+                engine.toggleFlag(mineTile);
+                solver.flagToggled(engine.core, mineTile);
+            } else {
+                break; // A guess would be needed
+            }
+        }
+    }
+    return wrong;
+}
+
+int main() {
+    cout << left << setw(10) << "board" << setw(14) << "size" << setw(8) << "games" << setw(12) << "moves"
+         << setw(10) << "guesses" << setw(14) << "median (us)" << setw(14) << "p99 (us)" << "mean (us)" << endl;
+    runCase("expert", BoardConfig{30, 16, 99}, 2000);
+    runCase("huge", BoardConfig{1000, 1000, 206250}, 1);
+
+    int wrongProofs = countWrongProofs(2000);
+    cout << endl << "Checks:" << endl;
+    cout << "  " << left << setw(60) << "wrong player flags never lead to a wrong proof" << (wrongProofs == 0 ? "ok" : "FAILED") << endl;
+    return wrongProofs == 0 ? 0 : 1;
+}
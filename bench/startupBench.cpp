@@ -0,0 +1,50 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include "../gameHelp.h"
+#include "benchCommon.h"
+using namespace std;
+using namespace sf;
+
+// Measures how long Board construction takes for several board sizes, with the shared
+// TextureCache versus the old approach of loading all 12 tile images for every tile.
+// Run from the project root so files/images can be found.
+
+// Reproduces the old Tile constructor cost: 12 PNG decodes and uploads per tile
+double timeLegacyTextureLoads(int tileCount) {
+    const char* files[12] = {
+        "files/images/tile_hidden.png", "files/images/tile_revealed.png", "files/images/mine.png",
+        "files/images/flag.png", "files/images/number_1.png", "files/images/number_2.png",
+        "files/images/number_3.png", "files/images/number_4.png", "files/images/number_5.png",
+        "files/images/number_6.png", "files/images/number_7.png", "files/images/number_8.png"
+    };
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < tileCount; i++) {
+        Texture perTile[12];
+        for (int j = 0; j < 12; j++) perTile[j].loadFromFile(files[j]);
+    }
+    return millisecondsSince(start);
+}
+
+int main() {
+    const BoardConfig sizes[] = {
+        {9, 9, 10}, {16, 16, 40}, {25, 16, 50}, {30, 16, 99}, {100, 100, 1500}, {200, 200, 6000}
+    };
+    const int legacyTileLimit = 10000; // The old path takes minutes beyond this, so it is skipped
+
+    // Build the tile atlas up front so every row measures board construction only
+    TextureCache::instance().tileAtlas();
+
+    cout << left << setw(12) << "board" << setw(10) << "tiles" << setw(16) << "cached (ms)" << "per-tile loads (ms)" << endl;
+    for (const BoardConfig& size : sizes) {
+        auto start = chrono::steady_clock::now();
+        Board board(size);
+        double cachedMs = millisecondsSince(start);
+
+        string boardName = to_string(size.columns) + "x" + to_string(size.rows);
+        cout << left << setw(12) << boardName << setw(10) << size.columns * size.rows << setw(16) << fixed << setprecision(2) << cachedMs;
+        if (size.columns * size.rows <= legacyTileLimit) cout << timeLegacyTextureLoads(size.columns * size.rows) << endl;
+        else cout << "skipped" << endl;
+    }
+    return 0;
+}
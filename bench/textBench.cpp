@@ -0,0 +1,109 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include "../gameHelp.h"
+#include "benchCommon.h"
+#include <SFML/Graphics.hpp>
+using namespace std;
+using namespace sf;
+
+// Measures the CPU time of one welcome-screen frame and one leaderboard frame, rendered into
+// an off-screen texture: the old way (a new Text built, styled and centered for every string
+// every frame, and the leaderboard string concatenated every frame) and with retained
+// TextWidgets that are only re-laid-out when their string changes.
+// Usage: textBench [font file]
+
+// Old helper from main.cpp: builds a Text and centers it on (xcoord, ycoord)
+Text setTheTextObj(const string& textString, Font& font, short size, Color color, float xcoord, float ycoord) {
+    Text text(textString, font, size);
+    text.setFillColor(color);
+    FloatRect rectOfText = text.getLocalBounds();
+    text.setOrigin(rectOfText.left + rectOfText.width / 2.0f, rectOfText.top + rectOfText.height / 2.0f);
+    text.setPosition(Vector2f(xcoord, ycoord));
+    return text;
+}
+
+// Old per-frame leaderboard string, built from five scores
+string buildScores() {
+    const int seconds[5] = {61, 95, 140, 305, 611};
+    const string names[5] = {"Alex", "Bruno", "Carl", "Dana", "Eve"};
+    string combined = "";
+    for (int i = 0; i < 5; i++) {
+        string minutes = (seconds[i] / 60 < 10 ? "0" : "") + to_string(seconds[i] / 60);
+        string secs = (seconds[i] % 60 < 10 ? "0" : "") + to_string(seconds[i] % 60);
+        combined += (i == 0 ? "" : "\n\n") + to_string(i + 1) + "\t" + minutes + ":" + secs + "\t" + names[i];
+    }
+    return combined;
+}
+
+int main(int argc, char* argv[]) {
+    Font font;
+    if (!font.loadFromFile(argc > 1 ? argv[1] : "files/font.ttf")) {
+        cout << "Failed to load font file!" << endl;
+        return 1;
+    }
+
+    const float width = 800, height = 612;
+    RenderTexture target;
+    target.create((unsigned)width, (unsigned)height);
+    const int frames = 2000;
+
+    // Welcome screen, old way
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < frames; i++) {
+        Text textWel = setTheTextObj("WELCOME TO MINESWEEPER!", font, 24, Color::White, width / 2, height / 2 - 150);
+        textWel.setStyle(Text::Bold | Text::Underlined);
+        Text promptOfText = setTheTextObj("Enter your name:", font, 20, Color::White, width / 2, height / 2 - 75);
+        promptOfText.setStyle(Text::Bold);
+        target.clear(Color::Blue);
+        target.draw(textWel);
+        target.draw(promptOfText);
+        target.display();
+    }
+    double welcomeOld = microsecondsSince(start) / frames;
+
+    // Welcome screen, retained
+    TextWidget textWel(font, 24, Color::White, Text::Bold | Text::Underlined, Vector2f(width / 2, height / 2 - 150), "WELCOME TO MINESWEEPER!");
+    TextWidget promptOfText(font, 20, Color::White, Text::Bold, Vector2f(width / 2, height / 2 - 75), "Enter your name:");
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < frames; i++) {
+        target.clear(Color::Blue);
+        textWel.draw(target);
+        promptOfText.draw(target);
+        target.display();
+    }
+    double welcomeNew = microsecondsSince(start) / frames;
+
+    // Leaderboard, old way
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < frames; i++) {
+        Text LBText = setTheTextObj("LEADERBOARD", font, 20, Color::White, width / 4, height / 4 - 120);
+        LBText.setStyle(Text::Bold | Text::Underlined);
+        Text highscoreText = setTheTextObj(buildScores(), font, 18, Color::White, width / 4, height / 4 + 20);
+        highscoreText.setStyle(Text::Bold);
+        target.clear(Color::Blue);
+        target.draw(LBText);
+        target.draw(highscoreText);
+        target.display();
+    }
+    double leaderboardOld = microsecondsSince(start) / frames;
+
+    // Leaderboard, retained
+    TextWidget LBText(font, 20, Color::White, Text::Bold | Text::Underlined, Vector2f(width / 4, height / 4 - 120), "LEADERBOARD");
+    TextWidget highscoreText(font, 18, Color::White, Text::Bold, Vector2f(width / 4, height / 4 + 20), buildScores());
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < frames; i++) {
+        target.clear(Color::Blue);
+        LBText.draw(target);
+        highscoreText.draw(target);
+        target.display();
+    }
+    double leaderboardNew = microsecondsSince(start) / frames;
+
+    cout << fixed << setprecision(1);
+    cout << left << setw(14) << "screen" << setw(22) << "rebuilt (us/frame)" << "retained (us/frame)" << endl;
+    cout << left << setw(14) << "welcome" << setw(22) << welcomeOld << welcomeNew << endl;
+    cout << left << setw(14) << "leaderboard" << setw(22) << leaderboardOld << leaderboardNew << endl;
+    return 0;
+}
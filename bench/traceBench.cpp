@@ -0,0 +1,101 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#define MS_TRACE // This benchmark always measures the traced build
+#include "../trace.h"
+#include "benchCommon.h"
+using namespace std;
+
+// Measures the cost of a TRACE_SCOPE in a tracing build (nanoseconds per scope on top of the
+// work it wraps), records from several threads at once into their own rings, and exports the
+// events as Chrome trace JSON. Checks that a full ring keeps exactly its newest events in order
+// and that the exported file holds every event of every ring. In a normal build TRACE_SCOPE
+// expands to nothing, so the untraced loop below is also what every scope costs there.
+// Exits with an error if a check fails.
+//
+// Usage: traceBench [scopes] (default 10000000)
+
+// A few nanoseconds of work the compiler can't remove, standing in for a small hot function
+uint64_t work(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDull;
+    return x ^ (x >> 29);
+}
+
+int main(int argc, char* argv[]) {
+    long long scopes = argc > 1 ? stoll(argv[1]) : 10000000;
+    BenchChecks checks(52, true);
+
+    // The same loop without and with a scope around the work
+    uint64_t sink = 1;
+    auto start = chrono::steady_clock::now();
+    for (long long i = 0; i < scopes; i++) sink = work(sink + i);
+    double untracedNs = nanosecondsSince(start) / scopes;
+
+    start = chrono::steady_clock::now();
+    for (long long i = 0; i < scopes; i++) {
+        TRACE_SCOPE("work");
+        sink = work(sink + i);
+    }
+    double tracedNs = nanosecondsSince(start) / scopes;
+
+    cout << "Scope cost: " << fixed << setprecision(1) << untracedNs << " ns untraced, " << tracedNs << " ns traced ("
+         << tracedNs - untracedNs << " ns per scope, ring of " << TRACE_RING_EVENTS << " events per thread)" << (sink == 0 ? " " : "") << endl;
+
+    cout << "Checks:" << endl;
+    checks.check("a full ring keeps its newest events", traceEventCount() == (size_t)min<long long>(scopes, TRACE_RING_EVENTS));
+
+    // Four threads recording at once, each into its own ring
+    traceClear();
+    const int threads = 4, perThread = 20000;
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&]() {
+            uint64_t local = 1;
+            for (int i = 0; i < perThread; i++) {
+                TRACE_SCOPE("worker");
+                local = work(local + i);
+            }
+            if (local == 0) cout << "";
+        });
+    }
+    for (thread& worker : workers) worker.join();
+    size_t events = traceEventCount();
+    checks.check("threads record into their own rings", events == (size_t)threads * perThread);
+
+    // Export, then count the events in the file and check that each track's timestamps never go back
+    start = chrono::steady_clock::now();
+    const string path = "traceBench.json";
+    bool written = writeChromeTrace(path);
+    double exportMs = nanosecondsSince(start) / 1e6;
+    ifstream file(path);
+    stringstream contents;
+    contents << file.rdbuf();
+    string json = contents.str();
+    size_t exported = 0;
+    for (size_t at = json.find("\"ph\":\"X\""); at != string::npos; at = json.find("\"ph\":\"X\"", at + 1)) exported++;
+    bool ordered = true;
+    double lastTimestamp = -1;
+    string lastTrack;
+    for (size_t at = json.find("\"tid\":"); at != string::npos; at = json.find("\"tid\":", at + 1)) {
+        string track = json.substr(at + 6, json.find_first_of(",}", at) - at - 6);
+        size_t timestampAt = json.find("\"ts\":", at);
+        size_t nextTrack = json.find("\"tid\":", at + 1);
+        if (timestampAt == string::npos || (nextTrack != string::npos && timestampAt > nextTrack)) continue; // Metadata event
+        double timestamp = stod(json.substr(timestampAt + 5));
+        if (track == lastTrack && timestamp < lastTimestamp) ordered = false;
+        lastTrack = track;
+        lastTimestamp = timestamp;
+    }
+    cout << "  exported " << exported << " events (" << json.size() / 1024 << " KB) in " << setprecision(1) << exportMs << " ms" << endl;
+    checks.check("the export holds every event", written && exported == events && json.back() == '\n' && json.find("]}") != string::npos);
+    checks.check("each thread's events are in time order", ordered);
+    remove(path.c_str());
+
+    return checks.report();
+}
@@ -0,0 +1,69 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "../gameHelp.h"
+#include "benchCommon.h"
+#include <SFML/Graphics.hpp>
+using namespace std;
+using namespace sf;
+
+// Measures the CPU time of drawing the board through a 1280x720 camera into an off-screen
+// texture, for boards from expert size to 5000x5000: a frame with nothing changed, a frame
+// while panning (every visible quad rewritten) and a minimap update after a reveal. With
+// culling the frame cost follows the viewport, so the times should stay flat as the board
+// grows. Must be run from the game directory (it loads the tile images).
+
+int main() {
+    const float width = 1280, height = 720;
+    RenderTexture target;
+    target.create((unsigned)width, (unsigned)height);
+    TextureCache::instance().tileAtlas(); // Build the atlas before timing
+    const int frames = 200;
+    const int sides[][2] = {{30, 16}, {100, 100}, {1000, 1000}, {5000, 5000}};
+
+    cout << left << setw(13) << "board" << setw(10) << "quads" << setw(16) << "still (us)" << setw(16) << "panning (us)"
+         << "minimap after reveal (us)" << endl;
+    for (const auto& side : sides) {
+        Board board(BoardConfig{side[0], side[1], side[0] * side[1] * 99 / 480}, 7);
+        board.reveal(board.core.index(side[1] / 2, side[0] / 2));
+        BoardCamera camera(width, height, width, height, board.columns, board.rows);
+        camera.centerOn(Vector2f(board.columns * TILE_SIZE / 2.0f, board.rows * TILE_SIZE / 2.0f));
+        target.setView(camera.getView());
+        board.draw(target, camera.visibleTiles()); // First frame builds the quads
+
+        // Nothing changed: the quads are reused as they are
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < frames; i++) board.draw(target, camera.visibleTiles());
+        double stillMicros = microsecondsSince(start) / frames;
+
+        // Panning by one tile per frame: the visible tiles change every frame
+        start = chrono::steady_clock::now();
+        for (int i = 0; i < frames; i++) {
+            camera.pan(Vector2f(i % 2 ? TILE_SIZE : -TILE_SIZE, 0));
+            target.setView(camera.getView());
+            board.draw(target, camera.visibleTiles());
+        }
+        double panMicros = microsecondsSince(start) / frames;
+
+        // A reveal only re-shades the minimap blocks it touched
+        target.setView(target.getDefaultView());
+        board.minimap.draw(target, board, Vector2f(width - 8, 8), camera.worldRect()); // First draw shades every block
+        double minimapMicros = 0;
+        int reveals = 0;
+        for (int i = 0; i < board.tiles && reveals < frames; i += 9973) {
+            if (board.core.isMine(i) || board.core.isRevealed(i)) continue;
+            board.reveal(i);
+            start = chrono::steady_clock::now();
+            board.minimap.draw(target, board, Vector2f(width - 8, 8), camera.worldRect());
+            minimapMicros += microsecondsSince(start);
+            reveals++;
+        }
+
+        cout << setw(13) << (to_string(side[0]) + "x" + to_string(side[1])) << setw(10) << board.renderer.quadCount()
+             << fixed << setprecision(1) << setw(16) << stillMicros << setw(16) << panMicros
+             << (reveals ? minimapMicros / reveals : 0) << endl;
+    }
+    return 0;
+}
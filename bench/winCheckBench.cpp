@@ -0,0 +1,53 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include "../gameEngine.h"
+using namespace std;
+
+// Measures the per-frame cost of the win check on a 500x500 board: the old full-board
+// scan for revealed safe tiles versus GameEngine::checkIfWinner, which reads the running
+// counter kept by BoardCore. The engine library must be built with -DNDEBUG (the Makefile's
+// default DEBUGFLAGS), otherwise its debug consistency check adds a scan to every call.
+
+int main() {
+    const int side = 500;
+    const int frames = 2000;
+
+    // A board with 15% mines and a partly played game (some regions revealed, some flags)
+    mt19937 rng(3);
+    GameEngine game(BoardConfig{side, side, side * side * 15 / 100}, 3);
+    vector<int> revealedTiles;
+    game.reveal(side * side / 2 + side / 2, revealedTiles); // Places the mines
+    for (int click = 0; click < 2000; click++) {
+        int index = rng() % (side * side);
+        if (game.core.isMine(index)) game.toggleFlag(index);
+        else game.reveal(index, revealedTiles);
+    }
+    const BoardCore& core = game.core;
+    int safeTiles = side * side - (int)count_if(core.state.begin(), core.state.end(), [](uint8_t tile) { return tile & TILE_MINE; });
+
+    // Old behaviour: scan every tile every frame
+    int wins = 0;
+    auto start = chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        if (core.countRevealedSafeTiles() == safeTiles) wins++;
+    }
+    double scanUs = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / frames;
+
+    // New behaviour: the engine's win check, which compares the running counter
+    start = chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        if (game.checkIfWinner()) wins++;
+    }
+    double counterUs = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / frames;
+
+    cout << "board " << side << "x" << side << ", " << core.revealedSafeTiles << " of " << safeTiles << " safe tiles revealed" << endl;
+    cout << fixed << setprecision(3);
+    cout << "win check per frame: full scan " << scanUs << " us, checkIfWinner (running counter) " << counterUs << " us" << endl;
+    cout << "frame budget used at 60 fps: full scan " << scanUs / 166.67 << "%, checkIfWinner " << counterUs / 166.67 << "%" << endl;
+    if (!core.countersMatchScan() || wins != 0) cout << "warning: counters disagree with a full scan" << endl;
+    if (counterUs * 10 > scanUs) cout << "warning: checkIfWinner still scans the board (libmsengine.a built without -DNDEBUG?)" << endl;
+    return 0;
+}
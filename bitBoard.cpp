@@ -0,0 +1,494 @@
+#include "bitBoard.h"
+#include "trace.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BIT_KERNELS_AVX2 1 // GCC and MinGW can compile AVX2 functions without -mavx2 for the whole build
+#include <immintrin.h>
+#endif
+
+// Positions of the state bits in a tile byte, in plane order (count bits first)
+const int MINE_BIT = 4, FLAGGED_BIT = 5, REVEALED_BIT = 6, ENABLED_BIT = 7;
+static_assert(TILE_COUNT_MASK == 0x0F && TILE_MINE == 1 << MINE_BIT && TILE_FLAGGED == 1 << FLAGGED_BIT &&
+              TILE_REVEALED == 1 << REVEALED_BIT && TILE_ENABLED == 1 << ENABLED_BIT, "bitplanes follow the TILE_* bits");
+
+// The SpreadTable struct maps each byte to 8 bytes holding its bits (bit i of the byte in the lowest bit of byte i).
+struct SpreadTable {
+    uint64_t bytes[256];
+};
+
+// Builds the spread table at compile time
+constexpr SpreadTable makeSpreadTable() {
+    SpreadTable table{};
+    for (int value = 0; value < 256; value++) {
+        uint64_t spread = 0;
+        for (int i = 0; i < 8; i++) spread |= (uint64_t)((value >> i) & 1) << (8 * i);
+        table.bytes[value] = spread;
+    }
+    return table;
+}
+
+static constexpr SpreadTable SPREAD = makeSpreadTable();
+const uint64_t LOW_BIT_OF_EACH_BYTE = 0x0101010101010101ull;
+
+// Majority of three bit vectors: the carry of a bit-sliced full adder
+static inline uint64_t majority(uint64_t a, uint64_t b, uint64_t c) {
+    return (a & b) | (c & (a ^ b));
+}
+
+// Packs bit 'bit' of tiles 'first' to 'count' - 1 into 'bits' (ORed into words that start zeroed)
+static void packBitFrom(const uint8_t* tiles, int first, int count, int bit, uint64_t* bits) {
+    for (int j = first; j < count; j++) bits[j / 64] |= (uint64_t)((tiles[j] >> bit) & 1) << (j % 64);
+}
+
+// Merges planes into tiles 'first' to 'count' - 1 one tile at a time
+static void mergeBitsFrom(const uint64_t* const* planes, int planeCount, int first, int count, uint8_t* tiles) {
+    uint8_t keep = (uint8_t)(0xFF << planeCount);
+    for (int j = first; j < count; j++) {
+        uint8_t low = 0;
+        for (int k = 0; k < planeCount; k++) low |= (uint8_t)(((planes[k][j / 64] >> (j % 64)) & 1) << k);
+        tiles[j] = (uint8_t)((tiles[j] & keep) | low);
+    }
+}
+
+// Packs 8 tiles per step: the chosen bit of each byte is moved to the lowest bit, and one
+// multiplication gathers the 8 lowest bits into the top byte
+static void packBitScalar(const uint8_t* tiles, int count, int bit, uint64_t* bits) {
+    memset(bits, 0, sizeof(uint64_t) * ((count + 63) / 64));
+    int j = 0;
+    for (; j + 8 <= count; j += 8) {
+        uint64_t eight;
+        memcpy(&eight, tiles + j, 8);
+        eight = (eight >> bit) & LOW_BIT_OF_EACH_BYTE;
+        bits[j / 64] |= ((eight * 0x0102040810204080ull) >> 56) << (j % 64);
+    }
+    packBitFrom(tiles, j, count, bit, bits);
+}
+
+// Adds up the 3x3 blocks of a row in bit-sliced form. The mines of each column of the three rows
+// make a 2-bit sum; the sums of the columns to the left and right come from shifting the words,
+// with the bits across a word edge taken from the word beside it (the padding words at the ends).
+static void countRowScalar(const uint64_t* above, const uint64_t* row, const uint64_t* below, int words, uint64_t* const counts[BIT_COUNT_PLANES]) {
+    for (int w = 0; w < words; w++) {
+        // Column sums (low and high bit) of the word and the words on either side
+        uint64_t low = above[w] ^ row[w] ^ below[w], high = majority(above[w], row[w], below[w]);
+        uint64_t lowLeft = above[w - 1] ^ row[w - 1] ^ below[w - 1], highLeft = majority(above[w - 1], row[w - 1], below[w - 1]);
+        uint64_t lowRight = above[w + 1] ^ row[w + 1] ^ below[w + 1], highRight = majority(above[w + 1], row[w + 1], below[w + 1]);
+
+        // The sums of the columns to the left (x) and right (z) of each tile
+        uint64_t x0 = (low << 1) | (lowLeft >> 63), x1 = (high << 1) | (highLeft >> 63);
+        uint64_t z0 = (low >> 1) | (lowRight << 63), z1 = (high >> 1) | (highRight << 63);
+
+        // x + sum + z, a number from 0 to 9 in four bits (a tile's own mine is only counted on mines, whose count is cleared)
+        uint64_t bit0 = x0 ^ low ^ z0, carry0 = majority(x0, low, z0);
+        uint64_t ones = x1 ^ high ^ z1, twos = majority(x1, high, z1);
+        uint64_t bit1 = ones ^ carry0, carry1 = ones & carry0;
+        uint64_t safe = ~row[w];
+        counts[0][w] = bit0 & safe;
+        counts[1][w] = bit1 & safe;
+        counts[2][w] = (twos ^ carry1) & safe;
+        counts[3][w] = (twos & carry1) & safe;
+    }
+}
+
+// Merges 8 tiles per step with the spread table
+static void mergeBitsScalar(const uint64_t* const* planes, int planeCount, int count, uint8_t* tiles) {
+    uint64_t keep = (uint8_t)(0xFF << planeCount) * LOW_BIT_OF_EACH_BYTE;
+    int j = 0;
+    for (; j + 8 <= count; j += 8) {
+        uint64_t bits = 0;
+        for (int k = 0; k < planeCount; k++) bits |= SPREAD.bytes[(planes[k][j / 64] >> (j % 64)) & 0xFF] << k;
+        uint64_t eight;
+        memcpy(&eight, tiles + j, 8);
+        eight = (eight & keep) | bits;
+        memcpy(tiles + j, &eight, 8);
+    }
+    mergeBitsFrom(planes, planeCount, j, count, tiles);
+}
+
+const BitKernels SCALAR_BIT_KERNELS = {packBitScalar, countRowScalar, mergeBitsScalar, "scalar"};
+
+#ifdef BIT_KERNELS_AVX2
+// Packs 32 tiles per step: shifting the chosen bit to the top of each byte lets movemask collect them
+__attribute__((target("avx2"))) static void packBitAvx2(const uint8_t* tiles, int count, int bit, uint64_t* bits) {
+    memset(bits, 0, sizeof(uint64_t) * ((count + 63) / 64));
+    int j = 0;
+    for (; j + 32 <= count; j += 32) {
+        __m256i bytes = _mm256_loadu_si256((const __m256i*)(tiles + j));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_slli_epi64(bytes, 7 - bit)); // Bits shifted in from the byte below never reach bit 7
+        bits[j / 64] |= (uint64_t)mask << (j % 64);
+    }
+    packBitFrom(tiles, j, count, bit, bits);
+}
+
+// Bit-sliced sums of three 256-bit vectors
+__attribute__((target("avx2"))) static inline __m256i majority(__m256i a, __m256i b, __m256i c) {
+    return _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_xor_si256(a, b)));
+}
+
+__attribute__((target("avx2"))) static inline __m256i load(const uint64_t* words) {
+    return _mm256_loadu_si256((const __m256i*)words);
+}
+
+// The scalar count, 4 words (256 tiles) per step: the words on either side are unaligned loads one word over
+__attribute__((target("avx2"))) static void countRowAvx2(const uint64_t* above, const uint64_t* row, const uint64_t* below, int words, uint64_t* const counts[BIT_COUNT_PLANES]) {
+    int w = 0;
+    for (; w + 4 <= words; w += 4) {
+        __m256i a = load(above + w), c = load(row + w), b = load(below + w);
+        __m256i aLeft = load(above + w - 1), cLeft = load(row + w - 1), bLeft = load(below + w - 1);
+        __m256i aRight = load(above + w + 1), cRight = load(row + w + 1), bRight = load(below + w + 1);
+        __m256i low = _mm256_xor_si256(_mm256_xor_si256(a, c), b), high = majority(a, c, b);
+        __m256i lowLeft = _mm256_xor_si256(_mm256_xor_si256(aLeft, cLeft), bLeft), highLeft = majority(aLeft, cLeft, bLeft);
+        __m256i lowRight = _mm256_xor_si256(_mm256_xor_si256(aRight, cRight), bRight), highRight = majority(aRight, cRight, bRight);
+
+        __m256i x0 = _mm256_or_si256(_mm256_slli_epi64(low, 1), _mm256_srli_epi64(lowLeft, 63));
+        __m256i x1 = _mm256_or_si256(_mm256_slli_epi64(high, 1), _mm256_srli_epi64(highLeft, 63));
+        __m256i z0 = _mm256_or_si256(_mm256_srli_epi64(low, 1), _mm256_slli_epi64(lowRight, 63));
+        __m256i z1 = _mm256_or_si256(_mm256_srli_epi64(high, 1), _mm256_slli_epi64(highRight, 63));
+
+        __m256i bit0 = _mm256_xor_si256(_mm256_xor_si256(x0, low), z0), carry0 = majority(x0, low, z0);
+        __m256i ones = _mm256_xor_si256(_mm256_xor_si256(x1, high), z1), twos = majority(x1, high, z1);
+        __m256i bit1 = _mm256_xor_si256(ones, carry0), carry1 = _mm256_and_si256(ones, carry0);
+        _mm256_storeu_si256((__m256i*)(counts[0] + w), _mm256_andnot_si256(c, bit0));
+        _mm256_storeu_si256((__m256i*)(counts[1] + w), _mm256_andnot_si256(c, bit1));
+        _mm256_storeu_si256((__m256i*)(counts[2] + w), _mm256_andnot_si256(c, _mm256_xor_si256(twos, carry1)));
+        _mm256_storeu_si256((__m256i*)(counts[3] + w), _mm256_andnot_si256(c, _mm256_and_si256(twos, carry1)));
+    }
+    if (w < words) {
+        uint64_t* const rest[BIT_COUNT_PLANES] = {counts[0] + w, counts[1] + w, counts[2] + w, counts[3] + w};
+        countRowScalar(above + w, row + w, below + w, words - w, rest);
+    }
+}
+
+// Merges 32 tiles per step: each byte picks the byte of the plane word holding its bit
+// (shuffle), tests its own bit (and + compare) and keeps the plane's bit value
+__attribute__((target("avx2"))) static void mergeBitsAvx2(const uint64_t* const* planes, int planeCount, int count, uint8_t* tiles) {
+    const __m256i whichByte = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+                                               2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+    const __m256i whichBit = _mm256_set1_epi64x((long long)0x8040201008040201ull);
+    const __m256i keep = _mm256_set1_epi8((char)(0xFF << planeCount));
+    int j = 0;
+    for (; j + 32 <= count; j += 32) {
+        __m256i bits = _mm256_setzero_si256();
+        for (int k = 0; k < planeCount; k++) {
+            __m256i chunk = _mm256_set1_epi32((int)(uint32_t)(planes[k][j / 64] >> (j % 64)));
+            __m256i set = _mm256_cmpeq_epi8(_mm256_and_si256(_mm256_shuffle_epi8(chunk, whichByte), whichBit), whichBit);
+            bits = _mm256_or_si256(bits, _mm256_and_si256(set, _mm256_set1_epi8((char)(1 << k))));
+        }
+        __m256i eight = _mm256_loadu_si256((const __m256i*)(tiles + j));
+        _mm256_storeu_si256((__m256i*)(tiles + j), _mm256_or_si256(_mm256_and_si256(eight, keep), bits));
+    }
+    mergeBitsFrom(planes, planeCount, j, count, tiles);
+}
+
+static const BitKernels AVX2_BIT_KERNELS = {packBitAvx2, countRowAvx2, mergeBitsAvx2, "avx2"};
+#endif
+
+// Asks the CPU for AVX2
+const BitKernels* avx2BitKernels() {
+#ifdef BIT_KERNELS_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return &AVX2_BIT_KERNELS;
+#endif
+    return nullptr;
+}
+
+const BitKernels* bestBitKernels() {
+    static const BitKernels* best = avx2BitKernels() ? avx2BitKernels() : &SCALAR_BIT_KERNELS;
+    return best;
+}
+
+void countNearbyMinesBitwise(BoardCore& core, const BitKernels* kernels) {
+    countNearbyMinesBitwise(core, 0, core.rows, nullptr, nullptr, kernels);
+}
+
+// Packs the mines of three rows at a time into a rolling set of padded rows (the row below is
+// packed just before it is needed, over the row that is no longer needed), then counts and merges
+// one row at a time. The extra memory is a few rows of words, however large the board.
+void countNearbyMinesBitwise(BoardCore& core, int firstRow, int endRow, const uint64_t* mineRowAbove, const uint64_t* mineRowBelow,
+                             const BitKernels* kernels) {
+    int words = (core.columns + 63) / 64;
+    int stride = words + 2;
+    vector<uint64_t> mineRows(6 * (size_t)stride, 0); // Three rolling rows, a row that stays zero, and the rows above and below
+    uint64_t* zeroRow = &mineRows[3 * (size_t)stride + 1];
+    uint64_t* above = zeroRow;
+    uint64_t* below = zeroRow;
+    if (mineRowAbove) above = copy(mineRowAbove, mineRowAbove + words, &mineRows[4 * (size_t)stride + 1]) - words;
+    if (mineRowBelow) below = copy(mineRowBelow, mineRowBelow + words, &mineRows[5 * (size_t)stride + 1]) - words;
+    auto mineRow = [&](int i) -> uint64_t* {
+        if (i < firstRow) return above;
+        if (i >= endRow) return below;
+        return &mineRows[(size_t)((i - firstRow) % 3) * stride + 1];
+    };
+    auto pack = [&](int i) {
+        if (i < endRow) kernels->packBit(&core.state[(size_t)i * core.columns], core.columns, MINE_BIT, mineRow(i));
+    };
+
+    vector<uint64_t> countWords((size_t)BIT_COUNT_PLANES * words);
+    uint64_t* const counts[BIT_COUNT_PLANES] = {&countWords[0], &countWords[words], &countWords[2 * words], &countWords[3 * words]};
+    pack(firstRow);
+    for (int i = firstRow; i < endRow; i++) {
+        pack(i + 1); // Merging only writes count bits, so the mine bits read here are still the original ones
+        kernels->countRow(mineRow(i - 1), mineRow(i), mineRow(i + 1), words, counts);
+        kernels->mergeBits(counts, BIT_COUNT_PLANES, core.columns, &core.state[(size_t)i * core.columns]);
+    }
+}
+
+void packMineRow(const BoardCore& core, int row, uint64_t* bits, const BitKernels* kernels) {
+    kernels->packBit(&core.state[(size_t)row * core.columns], core.columns, MINE_BIT, bits);
+}
+
+// Allocates the zeroed planes and enables every tile on the board (the padding stays disabled)
+void BitBoard::resize(int rowCount, int columnCount) {
+    rows = rowCount;
+    columns = columnCount;
+    wordsPerRow = (columns + 63) / 64;
+    stride = wordsPerRow + 2;
+    size_t planeWords = (size_t)(rows + 2) * stride;
+    for (vector<uint64_t>* plane : {&mines, &flagged, &revealed, &enabled, &pending, &newly}) plane->assign(planeWords, 0);
+    for (vector<uint64_t>& plane : counts) plane.assign(planeWords, 0);
+    scratch.assign(3 * (size_t)stride, 0);
+    pendingFirst.assign(rows, wordsPerRow);
+    pendingLast.assign(rows, -1);
+    touchedFirst.assign(rows, wordsPerRow);
+    touchedLast.assign(rows, -1);
+    rowQueued.assign(rows, 0);
+    worklist.clear();
+    touchedRows.clear();
+    revealedSafeTiles = 0;
+
+    uint64_t lastWord = columns % 64 ? (1ull << (columns % 64)) - 1 : ~0ull;
+    for (int i = 0; i < rows; i++) {
+        uint64_t* row = &enabled[word(i, 0)];
+        for (int w = 0; w < wordsPerRow; w++) row[w] = w == wordsPerRow - 1 ? lastWord : ~0ull;
+    }
+}
+
+// Packs each state bit of each row into its plane
+void BitBoard::load(const BoardCore& core) {
+    resize(core.rows, core.columns);
+    vector<uint64_t>* planes[8] = {&counts[0], &counts[1], &counts[2], &counts[3], &mines, &flagged, &revealed, &enabled};
+    for (int i = 0; i < rows; i++) {
+        for (int bit = 0; bit < 8; bit++) kernels->packBit(&core.state[(size_t)i * columns], columns, bit, &(*planes[bit])[word(i, 0)]);
+    }
+    revealedSafeTiles = core.revealedSafeTiles;
+}
+
+// Merges all eight planes into each row of state bytes and recounts the flags
+void BitBoard::store(BoardCore& core) const {
+    core.resize(rows, columns);
+    int flags = 0, flaggedMines = 0;
+    for (int i = 0; i < rows; i++) {
+        size_t at = word(i, 0);
+        const uint64_t* planes[8] = {&counts[0][at], &counts[1][at], &counts[2][at], &counts[3][at], &mines[at], &flagged[at], &revealed[at], &enabled[at]};
+        kernels->mergeBits(planes, 8, columns, &core.state[(size_t)i * columns]);
+        for (int w = 0; w < wordsPerRow; w++) {
+            flags += __builtin_popcountll(flagged[at + w]);
+            flaggedMines += __builtin_popcountll(flagged[at + w] & mines[at + w]);
+        }
+    }
+    core.revealedSafeTiles = revealedSafeTiles;
+    core.flagsPlaced = flags;
+    core.correctFlags = flaggedMines;
+    core.minesPlaced = true; // The counts are stored with the tiles
+}
+
+// Places a mine, keeping the counter in step if the tile was already revealed
+void BitBoard::setMine(int index) {
+    int row = index / columns, column = index % columns;
+    size_t at = word(row, column);
+    if (mines[at] & bit(column)) return;
+    if (revealed[at] & bit(column)) revealedSafeTiles--;
+    mines[at] |= bit(column);
+}
+
+// Counts every row straight into the count planes; the bits past the last column are cleared
+// so the padding stays zero
+void BitBoard::countNearbyMines() {
+    uint64_t lastWord = columns % 64 ? (1ull << (columns % 64)) - 1 : ~0ull;
+    for (int i = 0; i < rows; i++) {
+        size_t at = word(i, 0);
+        uint64_t* const rowCounts[BIT_COUNT_PLANES] = {&counts[0][at], &counts[1][at], &counts[2][at], &counts[3][at]};
+        kernels->countRow(&mines[at - stride], &mines[at], &mines[at + stride], wordsPerRow, rowCounts);
+        for (uint64_t* plane : rowCounts) plane[wordsPerRow - 1] &= lastWord;
+    }
+}
+
+// Spreads 'seeds' along the runs of set bits of 'through' (a Kogge-Stone occluded fill inside
+// each word), up the row and then back down it, so a run is filled whichever end it is entered from
+static void fillRuns(uint64_t* seeds, const uint64_t* through, int words) {
+    uint64_t carry = 0;
+    for (int w = 0; w < words; w++) {
+        uint64_t fill = seeds[w] | (carry & through[w]), open = through[w];
+        fill |= open & (fill << 1);  open &= open << 1;
+        fill |= open & (fill << 2);  open &= open << 2;
+        fill |= open & (fill << 4);  open &= open << 4;
+        fill |= open & (fill << 8);  open &= open << 8;
+        fill |= open & (fill << 16); open &= open << 16;
+        fill |= open & (fill << 32);
+        seeds[w] = fill;
+        carry = fill >> 63; // Continues into the first column of the next word
+    }
+    carry = 0;
+    for (int w = words - 1; w >= 0; w--) {
+        uint64_t fill = seeds[w] | ((carry << 63) & through[w]), open = through[w];
+        fill |= open & (fill >> 1);  open &= open >> 1;
+        fill |= open & (fill >> 2);  open &= open >> 2;
+        fill |= open & (fill >> 4);  open &= open >> 4;
+        fill |= open & (fill >> 8);  open &= open >> 8;
+        fill |= open & (fill >> 16); open &= open >> 16;
+        fill |= open & (fill >> 32);
+        seeds[w] = fill;
+        carry = fill & 1;
+    }
+}
+
+// Queues the tiles of 'reach' in 'row' that can still be revealed and are not already pending
+void BitBoard::addPending(int row, const uint64_t* reach, int first, int last) {
+    if (row < 0 || row >= rows) return;
+    size_t at = word(row, 0);
+    bool added = false;
+    for (int w = first; w <= last; w++) {
+        uint64_t tiles = reach[w] & hiddenAt(at + w) & ~pending[at + w];
+        if (!tiles) continue;
+        pending[at + w] |= tiles;
+        pendingFirst[row] = min(pendingFirst[row], w);
+        pendingLast[row] = max(pendingLast[row], w);
+        added = true;
+    }
+    if (added && !rowQueued[row]) {
+        rowQueued[row] = 1;
+        worklist.push_back(row);
+    }
+}
+
+void BitBoard::touch(int row, int w) {
+    if (touchedFirst[row] > touchedLast[row]) touchedRows.push_back(row);
+    touchedFirst[row] = min(touchedFirst[row], w);
+    touchedLast[row] = max(touchedLast[row], w);
+}
+
+void BitBoard::markRevealed(int row, const uint64_t* bits, int first, int last) {
+    size_t at = word(row, 0);
+    for (int w = first; w <= last; w++) {
+        if (!bits[w]) continue;
+        revealed[at + w] |= bits[w];
+        newly[at + w] |= bits[w];
+        touch(row, w);
+    }
+}
+
+// One step of the dilation: the pending tiles of the row are revealed, the empty ones among them
+// fill the runs of hidden empty tiles they touch, and the filled tiles reveal their neighbors in the
+// row and pass the ones above and below on to those rows
+void BitBoard::revealRow(int row) {
+    size_t at = word(row, 0);
+    int first = pendingFirst[row], last = pendingLast[row];
+    pendingFirst[row] = wordsPerRow;
+    pendingLast[row] = -1;
+    uint64_t* seeds = &scratch[1];                 // Padded, so the dilation can read one word past each end
+    uint64_t* through = &scratch[stride + 1];      // Hidden empty tiles the fill may cross, then the dilated fill
+    uint64_t* rowTiles = &scratch[2 * stride + 1]; // Tiles revealed in this row
+    bool anySeeds = false;
+    for (int w = first; w <= last; w++) {
+        uint64_t hidden = hiddenAt(at + w), empty = emptyAt(at + w);
+        rowTiles[w] = pending[at + w] & hidden;
+        pending[at + w] = 0;
+        seeds[w] = rowTiles[w] & empty;
+        through[w] = hidden & empty;
+        anySeeds = anySeeds || seeds[w] != 0;
+    }
+
+    if (anySeeds) {
+        // A run of hidden empty tiles may carry the fill past the window, so widen it while a run crosses its edge
+        while (last + 1 < wordsPerRow && (through[last] >> 63) && (hiddenAt(at + last + 1) & emptyAt(at + last + 1) & 1)) {
+            last++;
+            through[last] = hiddenAt(at + last) & emptyAt(at + last);
+        }
+        while (first > 0 && (through[first] & 1) && ((hiddenAt(at + first - 1) & emptyAt(at + first - 1)) >> 63)) {
+            first--;
+            through[first] = hiddenAt(at + first) & emptyAt(at + first);
+        }
+        fillRuns(seeds + first, through + first, last - first + 1);
+
+        // The fill and its neighbors reach one word further on each side
+        first = max(first - 1, 0);
+        last = min(last + 1, wordsPerRow - 1);
+        for (int w = first; w <= last; w++) {
+            through[w] = seeds[w] | (seeds[w] << 1) | (seeds[w - 1] >> 63) | (seeds[w] >> 1) | (seeds[w + 1] << 63);
+            rowTiles[w] |= through[w] & hiddenAt(at + w);
+        }
+        markRevealed(row, rowTiles, first, last);
+        addPending(row - 1, through, first, last);
+        addPending(row + 1, through, first, last);
+    } else {
+        markRevealed(row, rowTiles, first, last); // Only numbered tiles: nothing spreads
+    }
+
+    for (int w = first; w <= last; w++) seeds[w] = through[w] = rowTiles[w] = 0;
+}
+
+// Reveals the clicked tile and, if it is empty, seeds the 3x3 block around it, then works through
+// the rows with pending tiles until none are left
+void BitBoard::reveal(int index, vector<int>& revealedTiles) {
+    TRACE_SCOPE("BitBoard::reveal");
+    int row = index / columns, column = index % columns;
+    size_t at = word(row, column);
+    uint64_t tile = bit(column);
+    if (flagged[at] & tile) return; // Do not reveal flagged tiles
+
+    // The clicked tile is expanded even if it was already revealed (like BoardCore::reveal)
+    if (!(emptyAt(at) & tile)) {
+        // A numbered (or disabled) tile opens nothing else, so it skips the flood fill (most clicks of a game)
+        if (!(revealed[at] & tile)) {
+            revealed[at] |= tile;
+            if (!(mines[at] & tile)) revealedSafeTiles++;
+            revealedTiles.push_back(index);
+        }
+        return;
+    }
+
+    int w = column / 64;
+    if (!(revealed[at] & tile)) {
+        revealed[at] |= tile;
+        newly[at] |= tile;
+        touch(row, w);
+    }
+
+    // Seed the 3x3 block around the tile
+    uint64_t* block = &scratch[1];
+    block[w] |= tile | (tile << 1) | (tile >> 1);
+    if (column % 64 == 0) block[w - 1] |= 1ull << 63; // Spills into the word before (or the padding)
+    if (column % 64 == 63) block[w + 1] |= 1;         // Spills into the word after
+    int first = max(w - 1, 0), last = min(w + 1, wordsPerRow - 1);
+    addPending(row - 1, block, first, last);
+    addPending(row, block, first, last);
+    addPending(row + 1, block, first, last);
+    block[w - 1] = block[w] = block[w + 1] = 0; // revealRow relies on a zero scratch row
+
+    while (!worklist.empty()) {
+        int next = worklist.back();
+        worklist.pop_back();
+        rowQueued[next] = 0;
+        revealRow(next);
+    }
+
+    // List the newly revealed tiles row by row and count the safe ones
+    sort(touchedRows.begin(), touchedRows.end());
+    for (int i : touchedRows) {
+        size_t rowAt = word(i, 0);
+        for (int v = touchedFirst[i]; v <= touchedLast[i]; v++) {
+            uint64_t bits = newly[rowAt + v];
+            revealedSafeTiles += __builtin_popcountll(bits & ~mines[rowAt + v]);
+            while (bits) {
+                revealedTiles.push_back(i * columns + v * 64 + __builtin_ctzll(bits));
+                bits &= bits - 1;
+            }
+            newly[rowAt + v] = 0;
+        }
+        touchedFirst[i] = wordsPerRow;
+        touchedLast[i] = -1;
+    }
+    touchedRows.clear();
+}
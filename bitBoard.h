@@ -0,0 +1,121 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "boardCore.h"
+using namespace std;
+
+// Bit-parallel board kernels: a board stored as bitplanes, one bit per tile and one row of 64-bit
+// words per board row, so one word operation handles 64 tiles. Nearby mines are counted with
+// bit-sliced adders over whole rows (the count of every tile is a 4-bit number spread over four
+// count planes), and a reveal floods the empty region by dilating the newly revealed empty tiles
+// one row at a time, masked by the tiles that can still be revealed. The row kernels come in a
+// portable version and an AVX2 version (x86 GCC/MinGW builds), picked at run time from the CPU.
+
+const int BIT_COUNT_PLANES = 4; // Bits of a nearby-mine count (0-8).
+
+// The BitKernels struct holds the row kernels the bitplanes are built on.
+struct BitKernels {
+    // Sets bit j of 'bits' to bit 'bit' of tiles[j], for 'count' tiles (the rest of the last word is zero).
+    void (*packBit)(const uint8_t* tiles, int count, int bit, uint64_t* bits);
+
+    // Counts the mines around every tile of a row: 'above', 'row' and 'below' are the mine bits of three
+    // rows of 'words' words, each readable one word before and after (the padding words). Writes the
+    // count planes of the row, with zero for the tiles that are mines.
+    void (*countRow)(const uint64_t* above, const uint64_t* row, const uint64_t* below, int words, uint64_t* const counts[BIT_COUNT_PLANES]);
+
+    // Replaces the low 'planeCount' bits of each of 'count' tiles with bit j of planes[0], planes[1], ...
+    void (*mergeBits)(const uint64_t* const* planes, int planeCount, int count, uint8_t* tiles);
+
+    const char* name; // "scalar" or "avx2".
+};
+
+// The portable kernels, which run everywhere.
+extern const BitKernels SCALAR_BIT_KERNELS;
+
+// Returns the AVX2 kernels if this build has them and the CPU supports AVX2, or nullptr.
+const BitKernels* avx2BitKernels();
+
+// Returns the fastest kernels the CPU supports (checked once).
+const BitKernels* bestBitKernels();
+
+// Counts the nearby mines of every tile of 'core' with the bitplane kernels: packs the mine bits,
+// counts them row by row and writes the counts back into the state bytes. Gives exactly the same
+// tiles as BoardCore::countNearbyMines.
+void countNearbyMinesBitwise(BoardCore& core, const BitKernels* kernels = bestBitKernels());
+
+// Counts the nearby mines of rows 'firstRow' to 'endRow' - 1 only. 'mineRowAbove' and 'mineRowBelow'
+// are the packed mine bits of the rows just outside (see packMineRow), or null at the board edges, so
+// bands of rows can be counted in parallel without reading each other's tiles.
+void countNearbyMinesBitwise(BoardCore& core, int firstRow, int endRow, const uint64_t* mineRowAbove, const uint64_t* mineRowBelow,
+                             const BitKernels* kernels = bestBitKernels());
+
+// Packs the mine bits of row 'row' of 'core' into 'bits' ((columns + 63) / 64 words).
+void packMineRow(const BoardCore& core, int row, uint64_t* bits, const BitKernels* kernels = bestBitKernels());
+
+// The BitBoard class is a whole board stored as bitplanes. Each plane has a padding word before
+// and after every row and a padding row above and below the board, all zero, so the row kernels
+// read the neighbors of the edge tiles without any bounds checks.
+class BitBoard {
+public:
+    int rows = 0;        // Number of rows in the board.
+    int columns = 0;     // Number of columns in the board.
+    int wordsPerRow = 0; // Words holding the bits of one row.
+    int stride = 0;      // Words from one row to the next (wordsPerRow plus the two padding words).
+    vector<uint64_t> mines, flagged, revealed, enabled; // One plane per state bit.
+    vector<uint64_t> counts[BIT_COUNT_PLANES];          // Nearby-mine count planes (bit k of the count).
+    int revealedSafeTiles = 0;                          // Number of revealed tiles that are not mines.
+    const BitKernels* kernels = bestBitKernels();       // Row kernels used by load, store and countNearbyMines.
+
+    // Resizes the board and resets every tile to hidden, enabled and mine-free.
+    void resize(int rowCount, int columnCount);
+
+    // Copies every tile of 'core' (state bits and nearby-mine counts) and its revealed-safe-tile counter.
+    void load(const BoardCore& core);
+
+    // Writes the board into 'core' as packed state bytes, resizing it and setting its counters.
+    void store(BoardCore& core) const;
+
+    // Returns the word holding the tile at 'row' and 'column' in a plane, and its bit in the word.
+    size_t word(int row, int column) const { return (size_t)(row + 1) * stride + 1 + column / 64; }
+    static uint64_t bit(int column) { return 1ull << (column % 64); }
+
+    // Places a mine on the tile at 'index' (call countNearbyMines once every mine is placed).
+    void setMine(int index);
+
+    // Counts the nearby mines of every tile from the mine plane.
+    void countNearbyMines();
+
+    // Reveals the tile at 'index' and flood-fills the empty region around it, exactly like
+    // BoardCore::reveal (same tiles and counters), but appends the newly revealed tiles to
+    // 'revealedTiles' in row-major order instead of breadth-first order.
+    void reveal(int index, vector<int>& revealedTiles);
+
+private:
+    vector<uint64_t> pending;  // Tiles waiting to be revealed by the flood fill, per row.
+    vector<uint64_t> newly;    // Tiles revealed by the current reveal.
+    vector<uint64_t> scratch;  // Three padded rows for the row being filled (all zero between uses).
+    vector<int> pendingFirst, pendingLast; // Words of each row holding pending tiles (first > last when none).
+    vector<int> touchedFirst, touchedLast; // Words of each row holding newly revealed tiles.
+    vector<char> rowQueued;    // Rows on the flood fill's worklist.
+    vector<int> worklist;      // Rows with pending tiles.
+    vector<int> touchedRows;   // Rows with newly revealed tiles.
+
+    // Tiles of one plane word that can still be revealed (hidden, unflagged, enabled), and the enabled
+    // tiles with no nearby mines (the ones a reveal spreads from).
+    uint64_t hiddenAt(size_t at) const { return enabled[at] & ~flagged[at] & ~revealed[at]; }
+    uint64_t emptyAt(size_t at) const { return enabled[at] & ~(counts[0][at] | counts[1][at] | counts[2][at] | counts[3][at]); }
+
+    // Reveals the pending tiles of one row, fills the empty runs they start and passes the tiles
+    // they reach in the rows above and below on to those rows. Only the words around the pending
+    // tiles are visited, so a small region costs a few words per row whatever the board width.
+    void revealRow(int row);
+
+    // Adds words 'first' to 'last' of 'reach' (one row's words) to the pending tiles of 'row' that can still be revealed.
+    void addPending(int row, const uint64_t* reach, int first, int last);
+
+    // Marks the tiles of words 'first' to 'last' of 'bits' (one row's words) of 'row' revealed.
+    void markRevealed(int row, const uint64_t* bits, int first, int last);
+
+    // Adds word 'w' of 'row' to the words holding newly revealed tiles.
+    void touch(int row, int w);
+};
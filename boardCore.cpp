@@ -0,0 +1,319 @@
+#include "boardCore.h"
+#include "bitBoard.h"
+#include "trace.h"
+#include "workStealingPool.h"
+#include <algorithm>
+#include <deque>
+
+// The dynamic kernels: the edges of the board are found from its run-time size
+static void revealDynamic(BoardCore& core, int index, vector<int>& revealedTiles) {
+    core.revealWith(index, revealedTiles, [&core](int tile, auto visit) { core.forEachNeighbor(tile, visit); });
+}
+
+// Boards at least this wide count their mines with the bitplane kernels (bitBoard.h), which are
+// faster from about one 64-bit word per row; narrower boards count byte by byte.
+const int BITWISE_COUNT_MIN_COLUMNS = 64;
+
+static void countNearbyMinesDynamic(BoardCore& core) {
+    if (core.columns >= BITWISE_COUNT_MIN_COLUMNS) {
+        countNearbyMinesBitwise(core);
+        return;
+    }
+    vector<uint8_t> columnMines(core.columns + 2, 0);
+    vector<uint8_t> emptyRow(core.columns, 0);
+    BoardCore::countNearbyMinesWith(core.state.data(), core.rows, core.columns, columnMines.data(), emptyRow.data());
+}
+
+static int countRevealedSafeTilesDynamic(const BoardCore& core) {
+    return BoardCore::countRevealedSafeTilesWith(core.state.data(), (int)core.state.size());
+}
+
+const BoardKernels DYNAMIC_BOARD_KERNELS = {revealDynamic, countNearbyMinesDynamic, countRevealedSafeTilesDynamic, 0, 0};
+
+// Resizes the board and resets every tile to its starting state
+void BoardCore::resize(int rowCount, int columnCount) {
+    this->rows = rowCount;
+    this->columns = columnCount;
+    kernels = selectBoardKernels(rowCount, columnCount);
+    state.assign((size_t)rowCount * columnCount, TILE_ENABLED); // Hidden, enabled, no mine, no nearby mines
+    revealedSafeTiles = 0;
+    flagsPlaced = 0;
+    correctFlags = 0;
+    minesPlaced = false;
+}
+
+// Rewrites every tile in the existing storage (no allocation, unlike building a new board)
+void BoardCore::reset() {
+    fill(state.begin(), state.end(), TILE_ENABLED);
+    revealedSafeTiles = 0;
+    flagsPlaced = 0;
+    correctFlags = 0;
+    minesPlaced = false;
+}
+
+// Places a mine, keeping the counters in step if the tile was already flagged or revealed
+void BoardCore::setMine(int index) {
+    if (isMine(index)) return;
+    if (isFlagged(index)) correctFlags++;
+    if (isRevealed(index)) revealedSafeTiles--;
+    state[index] |= TILE_MINE;
+}
+
+// Toggles a flag and updates the flag counters
+void BoardCore::toggleFlag(int index) {
+    state[index] ^= TILE_FLAGGED;
+    int change = isFlagged(index) ? 1 : -1;
+    flagsPlaced += change;
+    if (isMine(index)) correctFlags += change;
+}
+
+// Places mines with a partial Fisher-Yates shuffle over the tiles outside the exclusion zone
+void BoardCore::placeMines(int mineCount, mt19937& rng, int safeIndex) {
+    TRACE_SCOPE("BoardCore::placeMines");
+    int tileCount = (int)state.size();
+    if (tileCount >= HUGE_BOARD_TILES) {
+        // A candidate list would cost 4 bytes per tile. Tasks already on the pool build their board alone
+        WorkStealingPool* pool = WorkStealingPool::onWorkerThread() ? nullptr : &WorkStealingPool::shared();
+        placeMinesInBands(mineCount, rng, safeIndex, pool);
+        return;
+    }
+    int safeRow = safeIndex >= 0 ? safeIndex / columns : -2;
+    int safeColumn = safeIndex >= 0 ? safeIndex % columns : -2;
+
+    // Spare the neighbors too, unless that would leave too few tiles for the mines
+    int zoneSize = 0;
+    if (safeIndex >= 0) forEachNeighbor(safeIndex, [&](int) { zoneSize++; });
+    int radius = (safeIndex >= 0 && mineCount <= tileCount - zoneSize - 1) ? 1 : 0;
+
+    // Collect every tile that may receive a mine
+    vector<int> candidates;
+    candidates.reserve(tileCount);
+    for (int i = 0; i < rows; i++) {
+        bool nearSafeRow = i >= safeRow - radius && i <= safeRow + radius;
+        for (int j = 0; j < columns; j++) {
+            if (nearSafeRow && j >= safeColumn - radius && j <= safeColumn + radius) continue;
+            candidates.push_back(i * columns + j);
+        }
+    }
+
+    // Move a random remaining candidate into each of the first 'mineCount' slots
+    if (mineCount > (int)candidates.size()) mineCount = (int)candidates.size();
+    for (int i = 0; i < mineCount; i++) {
+        uniform_int_distribution<int> pick(i, (int)candidates.size() - 1);
+        swap(candidates[i], candidates[pick(rng)]);
+        setMine(candidates[i]);
+    }
+
+    countNearbyMines();
+    minesPlaced = true;
+}
+
+// Selection sampling: walks the tiles once and takes each remaining candidate with probability
+// needed / left, which places exactly 'mineCount' mines with every layout equally likely
+void BoardCore::placeMinesInPlace(int mineCount, mt19937& rng, int safeIndex) {
+    int tileCount = (int)state.size();
+    int safeRow = safeIndex >= 0 ? safeIndex / columns : -2;
+    int safeColumn = safeIndex >= 0 ? safeIndex % columns : -2;
+
+    // Spare the neighbors too, unless that would leave too few tiles for the mines
+    int zoneSize = 0;
+    if (safeIndex >= 0) forEachNeighbor(safeIndex, [&](int) { zoneSize++; });
+    int radius = (safeIndex >= 0 && mineCount <= tileCount - zoneSize - 1) ? 1 : 0;
+    int excluded = 0;
+    if (safeIndex >= 0) excluded = radius ? zoneSize + 1 : 1;
+
+    long long left = tileCount - excluded; // Candidates not visited yet
+    long long needed = min<long long>(mineCount, left);
+    const double scale = 1.0 / 4294967296.0; // Maps a 32-bit draw to [0, 1)
+    for (int i = 0; i < rows && needed > 0; i++) {
+        bool nearSafeRow = i >= safeRow - radius && i <= safeRow + radius;
+        for (int j = 0; j < columns && needed > 0; j++) {
+            if (nearSafeRow && j >= safeColumn - radius && j <= safeColumn + radius) continue;
+            if ((rng() + 0.5) * scale * left < needed) {
+                setMine(i * columns + j); // Keeps the counters right for tiles flagged before the first reveal
+                needed--;
+            }
+            left--;
+        }
+    }
+
+    countNearbyMines();
+    minesPlaced = true;
+}
+
+// Returns a uniform double in [0, 1) with 53 random bits
+static double uniformUnit(mt19937& rng) {
+    uint32_t high = rng() >> 5, low = rng() >> 6;
+    return (high * 67108864.0 + low) / 9007199254740992.0;
+}
+
+// Draws how many of 'needed' mines land among the first 'taken' of 'left' candidates (hypergeometric).
+// The weights of the possible counts are built outward from the most likely one with the ratio of
+// neighboring terms, dropping the tails once they fall below 2^-64 of the total, then one uniform draw
+// picks a count. A band's count is within a few hundred of the mode, so this is a short walk.
+static long long drawHypergeometric(long long left, long long needed, long long taken, mt19937& rng) {
+    long long low = max(0LL, taken - (left - needed)), high = min(taken, needed);
+    if (low == high) return low;
+    long long mode = (long long)((taken + 1.0) * (needed + 1.0) / (left + 2.0));
+    mode = min(max(mode, low), high);
+
+    // ratio(k) = P(k + 1) / P(k)
+    auto ratio = [&](long long k) { return (double)(needed - k) * (taken - k) / ((double)(k + 1) * (left - needed - taken + k + 1)); };
+    const double tail = 1.0 / 18446744073709551616.0; // 2^-64
+    deque<double> weights = {1.0};
+    double total = 1.0;
+    long long first = mode;
+    for (long long k = mode; k < high; k++) {
+        double weight = weights.back() * ratio(k);
+        if (weight < total * tail) break;
+        weights.push_back(weight);
+        total += weight;
+    }
+    for (long long k = mode; k > low; k--) {
+        double weight = weights.front() / ratio(k - 1);
+        if (weight < total * tail) break;
+        weights.push_front(weight);
+        total += weight;
+        first--;
+    }
+
+    double target = uniformUnit(rng) * total;
+    for (size_t i = 0; i < weights.size(); i++) {
+        if (target < weights[i]) return first + (long long)i;
+        target -= weights[i];
+    }
+    return mode; // Only reached through rounding
+}
+
+// Splits the mines between the bands on the calling thread, then places and counts each band on the pool.
+// Every band only writes its own rows; the mine bits of its edge rows are copied out between the two
+// passes so the count pass never reads another band's tiles while that band writes its counts.
+void BoardCore::placeMinesInBands(int mineCount, mt19937& rng, int safeIndex, WorkStealingPool* pool, int bandRows) {
+    TRACE_SCOPE("BoardCore::placeMinesInBands");
+    int tileCount = (int)state.size();
+    int safeRow = safeIndex >= 0 ? safeIndex / columns : -2;
+    int safeColumn = safeIndex >= 0 ? safeIndex % columns : -2;
+
+    // Spare the neighbors too, unless that would leave too few tiles for the mines
+    int zoneSize = 0;
+    if (safeIndex >= 0) forEachNeighbor(safeIndex, [&](int) { zoneSize++; });
+    int radius = (safeIndex >= 0 && mineCount <= tileCount - zoneSize - 1) ? 1 : 0;
+    int zoneColumns = 0;
+    if (safeIndex >= 0) zoneColumns = min(columns - 1, safeColumn + radius) - max(0, safeColumn - radius) + 1;
+
+    if (bandRows <= 0) bandRows = max(1, CONSTRUCTION_BAND_TILES / max(1, columns));
+    int bandCount = (rows + bandRows - 1) / bandRows;
+
+    // The candidates of each band: its tiles minus the part of the safe zone it holds
+    vector<long long> bandCandidates(bandCount);
+    long long left = 0;
+    for (int b = 0; b < bandCount; b++) {
+        int first = b * bandRows, end = min(rows, first + bandRows);
+        int zoneRows = max(0, min(end - 1, safeRow + radius) - max(first, safeRow - radius) + 1);
+        bandCandidates[b] = (long long)(end - first) * columns - (long long)zoneRows * zoneColumns;
+        left += bandCandidates[b];
+    }
+
+    // Deal the mines out to the bands in order, then give every band its own stream
+    long long needed = min<long long>(mineCount, left);
+    vector<long long> bandMines(bandCount);
+    for (int b = 0; b < bandCount; b++) {
+        bandMines[b] = b == bandCount - 1 ? needed : drawHypergeometric(left, needed, bandCandidates[b], rng);
+        left -= bandCandidates[b];
+        needed -= bandMines[b];
+    }
+    uint32_t streamBase = rng();
+
+    auto run = [&](function<void()> task) {
+        if (pool) pool->submit(move(task));
+        else task();
+    };
+    auto finish = [&]() {
+        if (pool) pool->wait();
+    };
+
+    // Place the mines of each band by selection sampling, and copy out its edge rows
+    const BitKernels* bitKernels = bestBitKernels();
+    int words = (columns + 63) / 64;
+    vector<uint64_t> topRows((size_t)bandCount * words), bottomRows((size_t)bandCount * words);
+    vector<int> correctFlagChanges(bandCount, 0), revealedSafeChanges(bandCount, 0);
+    for (int b = 0; b < bandCount; b++) {
+        run([&, b]() {
+            seed_seq seeds = {streamBase, (uint32_t)b};
+            mt19937 bandRng(seeds);
+            int first = b * bandRows, end = min(rows, first + bandRows);
+            long long bandLeft = bandCandidates[b], bandNeeded = bandMines[b];
+            const double scale = 1.0 / 4294967296.0; // Maps a 32-bit draw to [0, 1)
+            for (int i = first; i < end && bandNeeded > 0; i++) {
+                bool nearSafeRow = i >= safeRow - radius && i <= safeRow + radius;
+                for (int j = 0; j < columns && bandNeeded > 0; j++) {
+                    if (nearSafeRow && j >= safeColumn - radius && j <= safeColumn + radius) continue;
+                    if ((bandRng() + 0.5) * scale * bandLeft < bandNeeded) {
+                        uint8_t& tile = state[(size_t)i * columns + j];
+                        if (tile & TILE_FLAGGED) correctFlagChanges[b]++; // The counters are merged once every band is done
+                        if (tile & TILE_REVEALED) revealedSafeChanges[b]--;
+                        tile |= TILE_MINE;
+                        bandNeeded--;
+                    }
+                    bandLeft--;
+                }
+            }
+            packMineRow(*this, first, &topRows[(size_t)b * words], bitKernels);
+            packMineRow(*this, end - 1, &bottomRows[(size_t)b * words], bitKernels);
+        });
+    }
+    finish();
+
+    // Count each band's rows with its neighbors' edge rows
+    for (int b = 0; b < bandCount; b++) {
+        run([&, b]() {
+            int first = b * bandRows, end = min(rows, first + bandRows);
+            const uint64_t* above = b > 0 ? &bottomRows[(size_t)(b - 1) * words] : nullptr;
+            const uint64_t* below = b + 1 < bandCount ? &topRows[(size_t)(b + 1) * words] : nullptr;
+            countNearbyMinesBitwise(*this, first, end, above, below, bitKernels);
+        });
+    }
+    finish();
+
+    for (int b = 0; b < bandCount; b++) {
+        correctFlags += correctFlagChanges[b];
+        revealedSafeTiles += revealedSafeChanges[b];
+    }
+    minesPlaced = true;
+}
+
+// Counts the mines around every safe tile with the kernel for this board size
+void BoardCore::countNearbyMines() {
+    kernels->countNearbyMines(*this);
+}
+
+// Sets or clears the enabled bit on every tile
+void BoardCore::setAllEnabled(bool enabled) {
+    for (uint8_t &tile : state) {
+        if (enabled) tile |= TILE_ENABLED;
+        else tile &= ~TILE_ENABLED;
+    }
+}
+
+// Reveals a tile and flood-fills the empty region with the kernel for this board size
+void BoardCore::reveal(int index, vector<int>& revealedTiles) {
+    kernels->reveal(*this, index, revealedTiles);
+}
+
+// Counts the revealed tiles that are not mines with the kernel for this board size
+int BoardCore::countRevealedSafeTiles() const {
+    return kernels->countRevealedSafeTiles(*this);
+}
+
+// Recounts the revealed, flagged and correctly flagged tiles and compares them with the counters
+bool BoardCore::countersMatchScan() const {
+    int flagged = 0;
+    int flaggedMines = 0;
+    for (uint8_t tile : state) {
+        if (tile & TILE_FLAGGED) {
+            flagged++;
+            if (tile & TILE_MINE) flaggedMines++;
+        }
+    }
+    return countRevealedSafeTiles() == revealedSafeTiles && flagged == flagsPlaced && flaggedMines == correctFlags;
+}
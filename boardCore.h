@@ -0,0 +1,222 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <random>
+using namespace std;
+
+// Bits of the packed per-tile state byte stored by BoardCore.
+const uint8_t TILE_COUNT_MASK = 0x0F; // Number of mines in the neighboring tiles (0-8).
+const uint8_t TILE_MINE = 0x10;       // The tile contains a mine.
+const uint8_t TILE_FLAGGED = 0x20;    // The tile is flagged.
+const uint8_t TILE_REVEALED = 0x40;   // The tile has been revealed.
+const uint8_t TILE_ENABLED = 0x80;    // The tile is interactable.
+
+// Boards with at least this many tiles (about 2048x2048) are huge boards: their mines are placed
+// without a per-tile candidate list, and the engine skips the work that scales with the board on
+// every frame or needs extra memory per tile (no-guess generation, debug counter scans). A board
+// costs one byte per tile plus the flood-fill worklist of a reveal. Indices are ints, so a board
+// holds at most 2^31 - 1 tiles.
+const int HUGE_BOARD_TILES = 1 << 22;
+
+// Huge boards are built in bands of whole rows holding about this many tiles each, in parallel.
+// The bands depend only on the board size, never on the number of threads.
+const int CONSTRUCTION_BAND_TILES = 1 << 20;
+
+class BoardCore;
+class WorkStealingPool;
+
+// The BoardKernels struct holds the board operations that also exist in a version compiled for
+// one board size (see fixedBoard.h). Every BoardCore points at the set that matches its size.
+struct BoardKernels {
+    void (*reveal)(BoardCore& core, int index, vector<int>& revealedTiles);
+    void (*countNearbyMines)(BoardCore& core);
+    int (*countRevealedSafeTiles)(const BoardCore& core);
+    int rows;    // Board size the kernels were compiled for (0 for the dynamic kernels).
+    int columns;
+};
+
+// The kernels for boards of any size, which find the edges of the board at run time.
+extern const BoardKernels DYNAMIC_BOARD_KERNELS;
+
+// Returns the kernels compiled for a board of 'rows' x 'columns' tiles, or DYNAMIC_BOARD_KERNELS
+// if that size has none (defined in fixedBoard.cpp).
+const BoardKernels* selectBoardKernels(int rows, int columns);
+
+// The BoardCore class stores every tile of a board in one flat, row-major buffer.
+// Each tile is a single packed state byte (see the TILE_* bits above), and a tile's
+// neighbors are found by index arithmetic instead of being stored.
+class BoardCore {
+public:
+    int rows = 0;          // Number of rows in the board.
+    int columns = 0;       // Number of columns in the board.
+    vector<uint8_t> state; // Packed tile states, indexed by row * columns + column.
+
+    // Running counters, kept up to date by setMine, toggleFlag and reveal so the win check is O(1).
+    int revealedSafeTiles = 0; // Number of revealed tiles that are not mines.
+    int flagsPlaced = 0;       // Number of flagged tiles.
+    int correctFlags = 0;      // Number of flagged tiles that are mines.
+    bool minesPlaced = false;  // Indicates whether placeMines has run since the last resize.
+    const BoardKernels* kernels = &DYNAMIC_BOARD_KERNELS; // Reveal and scan code for this size (chosen by resize).
+
+    // Resizes the board, resets every tile to hidden, enabled and mine-free, and picks the kernels for the new size.
+    void resize(int rowCount, int columnCount);
+
+    // Resets every tile to hidden, enabled and mine-free without changing the size, reusing the storage.
+    void reset();
+
+    // Returns the index of the tile at the given row and column.
+    int index(int row, int column) const { return row * columns + column; }
+
+    // Accessors for the packed state of the tile at 'index'.
+    bool isMine(int index) const { return state[index] & TILE_MINE; }
+    bool isFlagged(int index) const { return state[index] & TILE_FLAGGED; }
+    bool isRevealed(int index) const { return state[index] & TILE_REVEALED; }
+    bool isEnabled(int index) const { return state[index] & TILE_ENABLED; }
+    int nearbyMines(int index) const { return state[index] & TILE_COUNT_MASK; }
+
+    // Places a mine on the tile at 'index'.
+    void setMine(int index);
+
+    // Toggles the flagged state of the tile at 'index'.
+    void toggleFlag(int index);
+
+    // Calls visit(neighborIndex) for each of the up to 8 tiles around 'index'.
+    template <typename Visit>
+    void forEachNeighbor(int index, Visit visit) const {
+        int row = index / columns;
+        int column = index % columns;
+        int firstRow = row > 0 ? row - 1 : row;
+        int lastRow = row < rows - 1 ? row + 1 : row;
+        int firstColumn = column > 0 ? column - 1 : column;
+        int lastColumn = column < columns - 1 ? column + 1 : column;
+        for (int i = firstRow; i <= lastRow; i++) {
+            for (int j = firstColumn; j <= lastColumn; j++) {
+                if (i != row || j != column) visit(i * columns + j);
+            }
+        }
+    }
+
+    // Places exactly 'mineCount' mines uniformly at random and counts the nearby mines.
+    // If 'safeIndex' is a tile, that tile and its neighbors never receive a mine (only the tile
+    // itself is kept clear when the board is too full to spare its neighbors). Runs in time
+    // proportional to the number of tiles, whatever the mine density. Huge boards use
+    // placeMinesInBands on the shared thread pool, so the same seed gives a different layout above
+    // HUGE_BOARD_TILES.
+    void placeMines(int mineCount, mt19937& rng, int safeIndex = -1);
+
+    // Places the mines like placeMines, but with one pass of selection sampling over the tiles
+    // (each tile is taken with probability mines still needed / tiles still left) instead of
+    // shuffling a list of candidate indices, so no memory is needed beyond the board itself.
+    void placeMinesInPlace(int mineCount, mt19937& rng, int safeIndex = -1);
+
+    // Places the mines like placeMinesInPlace and counts the nearby mines, band by band on 'pool' (on
+    // the calling thread if it is null). The number of mines in each band of 'bandRows' rows (by
+    // default about CONSTRUCTION_BAND_TILES tiles) is drawn first, one hypergeometric draw per band in
+    // order, so the total is exact and every layout is still equally likely; then every band places
+    // its mines with its own random stream, and counts its rows with the bitplane kernels. The layout
+    // depends only on 'rng' and the band size, never on the number of threads.
+    void placeMinesInBands(int mineCount, mt19937& rng, int safeIndex = -1, WorkStealingPool* pool = nullptr, int bandRows = 0);
+
+    // Stores the number of neighboring mines in every tile that is not a mine.
+    void countNearbyMines();
+
+    // Enables or disables every tile.
+    void setAllEnabled(bool enabled);
+
+    // Reveals the tile at 'index' and, if it has no nearby mines, flood-fills the empty region around it.
+    // Appends the index of every newly revealed tile to 'revealedTiles'. The list doubles as the
+    // flood-fill worklist, so the stack depth stays constant however large the region is.
+    void reveal(int index, vector<int>& revealedTiles);
+
+    // Returns the number of revealed tiles that are not mines by scanning the whole board.
+    int countRevealedSafeTiles() const;
+
+    // Recounts every counter with a full scan and returns whether the running counters match.
+    bool countersMatchScan() const;
+
+    // The reveal algorithm behind every kernel: 'neighbors(index, visit)' calls visit(neighborIndex)
+    // for each tile around 'index', with the edge handling of the dynamic or the fixed-size board.
+    template <typename Neighbors>
+    void revealWith(int index, vector<int>& revealedTiles, Neighbors neighbors);
+
+    // The nearby-mine count behind every kernel, over a board of 'rows' x 'columns' tiles. The sizes
+    // are ints, or integral_constants in the fixed-size kernels so every loop bound is a constant.
+    // 'columnMines' (columns + 2 zeros) and 'emptyRow' (columns zeros) are the caller's scratch space.
+    template <typename Rows, typename Columns>
+    static void countNearbyMinesWith(uint8_t* state, Rows rows, Columns columns, uint8_t* columnMines, const uint8_t* emptyRow);
+
+    // The revealed-safe-tile count behind every kernel, over 'tiles' tiles (an int or an integral_constant).
+    template <typename Tiles>
+    static int countRevealedSafeTilesWith(const uint8_t* state, Tiles tiles);
+};
+
+// Reveals a tile and flood-fills outward from it with an explicit worklist
+template <typename Neighbors>
+void BoardCore::revealWith(int index, vector<int>& revealedTiles, Neighbors neighbors) {
+    if (isFlagged(index)) return; // Do not reveal flagged tiles
+
+    size_t first = revealedTiles.size(); // Tiles appended from here on are counted at the end
+
+    if (!isRevealed(index)) {
+        state[index] |= TILE_REVEALED;
+        revealedTiles.push_back(index);
+    }
+
+    // Reveals the hidden, unflagged, enabled neighbors of an empty tile and queues them
+    auto expand = [&](int tile) {
+        if (nearbyMines(tile) != 0 || !isEnabled(tile)) return;
+        neighbors(tile, [&](int neighbor) {
+            if (!(state[neighbor] & (TILE_REVEALED | TILE_FLAGGED)) && isEnabled(neighbor)) {
+                state[neighbor] |= TILE_REVEALED;
+                revealedTiles.push_back(neighbor);
+            }
+        });
+    };
+
+    // The clicked tile is expanded even if it was already revealed, then every tile
+    // revealed from here on is expanded in turn (breadth-first)
+    size_t next = revealedTiles.size();
+    expand(index);
+    while (next < revealedTiles.size()) {
+        expand(revealedTiles[next++]);
+    }
+
+    // Count the newly revealed tiles that are not mines
+    for (size_t i = first; i < revealedTiles.size(); i++) {
+        if (!isMine(revealedTiles[i])) revealedSafeTiles++;
+    }
+}
+
+// Counts the mines around every safe tile (mine tiles keep a count of zero). Works row by row:
+// first the mines in each column of the three rows around the current one, then a sliding sum
+// of three columns, so every tile costs a few additions with no per-neighbor bounds checks.
+template <typename Rows, typename Columns>
+void BoardCore::countNearbyMinesWith(uint8_t* state, Rows rows, Columns columns, uint8_t* columnMines, const uint8_t* emptyRow) {
+    uint8_t* sums = columnMines; // Padded with a zero column on each side
+    for (int i = 0; i < rows; i++) {
+        uint8_t* row = &state[(size_t)i * columns];
+        const uint8_t* above = i > 0 ? row - columns : emptyRow; // emptyRow stands in for the rows above the first and below the last
+        const uint8_t* below = i < rows - 1 ? row + columns : emptyRow;
+
+        for (int j = 0; j < columns; j++) {
+            sums[j + 1] = (uint8_t)(((above[j] & TILE_MINE) + (row[j] & TILE_MINE) + (below[j] & TILE_MINE)) >> 4);
+        }
+
+        for (int j = 0; j < columns; j++) {
+            uint8_t tile = row[j];
+            uint8_t count = (uint8_t)(sums[j] + sums[j + 1] + sums[j + 2]);
+            uint8_t safeMask = (uint8_t)(((tile & TILE_MINE) >> 4) - 1); // 0xFF for safe tiles, 0 for mines (no branch to mispredict)
+            row[j] = (uint8_t)((tile & ~TILE_COUNT_MASK) | (count & safeMask));
+        }
+    }
+}
+
+// Counts the revealed tiles that are not mines
+template <typename Tiles>
+int BoardCore::countRevealedSafeTilesWith(const uint8_t* state, Tiles tiles) {
+    int revealedSafeTiles = 0;
+    for (int i = 0; i < tiles; i++) {
+        if ((state[i] & (TILE_MINE | TILE_REVEALED)) == TILE_REVEALED) revealedSafeTiles++;
+    }
+    return revealedSafeTiles;
+}
@@ -0,0 +1,89 @@
+#include "boardGenerator.h"
+#include "gameEngine.h"
+#include "solver.h"
+#include "workStealingPool.h"
+#include "trace.h"
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <mutex>
+
+// Seeds a generator with the candidate's seed and places the mines around the safe tile
+void placeCandidateMines(BoardCore& core, int mineCount, int safeIndex, uint32_t layoutSeed) {
+    mt19937 layoutRng(layoutSeed);
+    core.placeMines(mineCount, layoutRng, safeIndex);
+}
+
+// Plays the candidate with proven moves only and checks that every safe tile gets revealed
+bool solvableWithoutGuessing(int rows, int columns, int mineCount, int safeIndex, uint32_t layoutSeed) {
+    TRACE_SCOPE("solvableWithoutGuessing"); // Runs on the pool's threads, one track each in the trace
+    BoardCore core;
+    core.resize(rows, columns);
+    placeCandidateMines(core, mineCount, safeIndex, layoutSeed);
+
+    Solver solver;
+    vector<int> revealedTiles;
+    core.reveal(safeIndex, revealedTiles);
+    solver.tilesRevealed(core, revealedTiles);
+
+    int safeTileCount = rows * columns - mineCount;
+    while (core.revealedSafeTiles < safeTileCount) {
+        solver.solve(core);
+        int safeTile = solver.nextSafeTile(core);
+        if (safeTile >= 0) {
+            revealedTiles.clear();
+            core.reveal(safeTile, revealedTiles);
+            solver.tilesRevealed(core, revealedTiles);
+            continue;
+        }
+
+        int mineTile = solver.nextMineTile(core);
+        if (mineTile < 0) return false; // A guess would be needed
+        core.toggleFlag(mineTile);
+        solver.flagToggled(core, mineTile);
+    }
+    return true;
+}
+
+// Submits one batch of candidates at a time; tasks above the best passing candidate are skipped
+bool findNoGuessLayout(int rows, int columns, int mineCount, int safeIndex, uint64_t seed, uint32_t& layoutSeed,
+                       GenerationReport* report, int maxAttempts, double maxMilliseconds) {
+    auto start = chrono::steady_clock::now();
+    auto deadline = start + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double, milli>(maxMilliseconds));
+    WorkStealingPool& pool = WorkStealingPool::shared();
+    const int batchSize = pool.size() * 4;
+
+    atomic<int> bestCandidate(INT_MAX); // Lowest passing candidate so far
+    atomic<int> attempts(0);
+    bool timedOut = false;
+
+    for (int first = 0; first < maxAttempts && bestCandidate == INT_MAX; first += batchSize) {
+        if (maxMilliseconds > 0 && chrono::steady_clock::now() >= deadline) {
+            timedOut = true; // The batch running at the limit has finished; start no other
+            break;
+        }
+        int last = min(maxAttempts, first + batchSize);
+        for (int candidate = first; candidate < last; candidate++) {
+            pool.submit([&, candidate]() {
+                if (candidate > bestCandidate) return; // A lower candidate already passed
+                attempts++;
+                if (!solvableWithoutGuessing(rows, columns, mineCount, safeIndex, streamSeed(seed, candidate))) return;
+
+                int best = bestCandidate;
+                while (candidate < best && !bestCandidate.compare_exchange_weak(best, candidate)) {}
+            });
+        }
+        pool.wait();
+    }
+
+    bool found = bestCandidate != INT_MAX;
+    if (found) layoutSeed = streamSeed(seed, bestCandidate);
+    if (report) {
+        report->found = found;
+        report->attempts = attempts;
+        report->candidate = found ? (int)bestCandidate : -1;
+        report->timedOut = timedOut;
+        report->milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    }
+    return found;
+}
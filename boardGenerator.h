@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include "boardCore.h"
+using namespace std;
+
+// How the mines are laid out on the first reveal (the optional fourth line of files/config.cfg).
+const int GENERATION_RANDOM = 0;   // Uniformly random layout (may need guesses).
+const int GENERATION_NO_GUESS = 1; // Only layouts the solver clears from the first click without guessing.
+const int GENERATION_ENDLESS = 2;  // A board with no edges, built in chunks as it is explored (see chunkedBoard.h).
+
+// The GenerationReport struct describes one search for a no-guess layout.
+struct GenerationReport {
+    bool found = false;        // Indicates whether a solvable layout was found.
+    int attempts = 0;          // Candidate layouts tested.
+    int candidate = -1;        // Number of the passing candidate (streamSeed(seed, candidate)), or -1.
+    bool timedOut = false;     // Indicates whether the search stopped at its time limit.
+    double milliseconds = 0;   // Wall time of the search.
+};
+
+// Places the mines of candidate 'layoutSeed' the way the engine does on a first click at 'safeIndex'.
+void placeCandidateMines(BoardCore& core, int mineCount, int safeIndex, uint32_t layoutSeed);
+
+// Returns whether the solver clears the candidate layout from 'safeIndex' by deduction alone.
+bool solvableWithoutGuessing(int rows, int columns, int mineCount, int safeIndex, uint32_t layoutSeed);
+
+// Tests candidate layouts (seeds streamSeed(seed, 0), streamSeed(seed, 1), ...) in parallel on the
+// shared work-stealing pool and stores the first one that is solvable without guessing in
+// 'layoutSeed'. Candidates are tested in batches and the lowest passing candidate wins, so the
+// result only depends on 'seed'. Gives up after 'maxAttempts' candidates and returns false. With a
+// 'maxMilliseconds' limit (0 for none) no batch starts after the limit, and the search also gives
+// up then: the result then depends on how many batches ran in time, not only on 'seed'.
+bool findNoGuessLayout(int rows, int columns, int mineCount, int safeIndex, uint64_t seed, uint32_t& layoutSeed,
+                       GenerationReport* report = nullptr, int maxAttempts = 100000, double maxMilliseconds = 0);
@@ -0,0 +1,89 @@
+#include "boardQueue.h"
+#include "trace.h"
+#include <algorithm>
+
+// Starts the background thread, which allocates the first boards
+BoardQueue::BoardQueue(int rowCount, int columnCount, int capacity) : rows(rowCount), columns(columnCount), capacity(max(0, capacity)) {
+    filler = thread([this]() { fillLoop(); });
+}
+
+// Wakes the background thread with the stop flag set and waits for it to exit
+BoardQueue::~BoardQueue() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    filler.join();
+}
+
+// Resets the boards handed back first (their storage is already there), then allocates new ones
+// until the queue is full. The slow work happens outside the lock, so take() never waits for it
+void BoardQueue::fillLoop() {
+    unique_lock<mutex> guard(lock);
+    while (true) {
+        workAvailable.wait(guard, [this]() { return stopping || !returned.empty() || ready.size() + building < capacity; });
+        if (stopping) return;
+
+        int targetRows = rows, targetColumns = columns;
+        BoardCore board;
+        bool recycled = !returned.empty();
+        if (recycled) {
+            board = move(returned.back());
+            returned.pop_back();
+        } else {
+            building++;
+        }
+        guard.unlock();
+        this_thread::yield(); // Woken by take(): let the restarting thread carry on before the long reset (matters on one core)
+
+        bool fits = board.rows == targetRows && board.columns == targetColumns && board.state.size() == (size_t)targetRows * targetColumns;
+        if (recycled && fits) {
+            TRACE_SCOPE("BoardQueue::reset");
+            board.reset();
+        } else if (!recycled) {
+            TRACE_SCOPE("BoardQueue::build");
+            board.resize(targetRows, targetColumns);
+            fits = true;
+        } else {
+            board = BoardCore(); // The size changed: free the storage here rather than on the game thread
+        }
+
+        guard.lock();
+        if (!recycled) building--;
+        if (fits && rows == targetRows && columns == targetColumns && ready.size() < capacity) {
+            ready.push_back(move(board));
+        } else if (!board.state.empty()) {
+            guard.unlock();
+            board = BoardCore(); // The size changed meanwhile or the queue is full: free it outside the lock
+            guard.lock();
+        }
+    }
+}
+
+// Moves the ready board in and the finished one out; both are just moves of the tile buffers
+bool BoardQueue::take(int rowCount, int columnCount, BoardCore& core) {
+    TRACE_SCOPE("BoardQueue::take");
+    bool taken = false;
+    {
+        lock_guard<mutex> guard(lock);
+        if (rowCount != rows || columnCount != columns) {
+            rows = rowCount;
+            columns = columnCount;
+            for (BoardCore& stale : ready) returned.push_back(move(stale)); // Freed by the background thread
+            ready.clear();
+        } else if (!ready.empty()) {
+            returned.push_back(move(core));
+            core = move(ready.front());
+            ready.pop_front();
+            taken = true;
+        }
+    }
+    workAvailable.notify_one();
+    return taken;
+}
+
+size_t BoardQueue::readyCount() {
+    lock_guard<mutex> guard(lock);
+    return ready.size();
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "boardCore.h"
+using namespace std;
+
+// The BoardQueue class keeps a few boards of one size reset and ready on a background thread, so a
+// restart swaps one in instead of building every tile while the player waits. The board a restart
+// replaces is handed back and reset in place on the same thread, so once the queue is full the
+// same storage goes round from game to game without being freed or allocated again. Mines are
+// still placed on the first reveal (around the clicked tile), so a ready board has none yet.
+class BoardQueue {
+    // Private member variables:
+    int rows;                          // Number of rows of the boards kept ready.
+    int columns;                       // Number of columns of the boards kept ready.
+    size_t capacity;                   // Number of boards kept ready.
+    deque<BoardCore> ready;            // Reset boards waiting to be taken.
+    vector<BoardCore> returned;        // Boards handed back, to reset (or to free, if the size changed).
+    size_t building = 0;               // New boards being allocated by the background thread.
+    mutex lock;                        // Guards every member above.
+    condition_variable workAvailable;  // Signaled when a board is handed back or the queue stops.
+    bool stopping = false;             // Tells the background thread to exit.
+    thread filler;                     // Resets the returned boards and tops the queue up.
+
+    // The loop of the background thread.
+    void fillLoop();
+
+public:
+    // Starts filling a queue of 'capacity' boards of 'rowCount' by 'columnCount' tiles (none if capacity is 0).
+    BoardQueue(int rowCount, int columnCount, int capacity = 2);
+
+    // Stops and joins the background thread; the boards still queued are freed.
+    ~BoardQueue();
+
+    BoardQueue(const BoardQueue&) = delete;
+    BoardQueue& operator=(const BoardQueue&) = delete;
+
+    // Swaps a ready board of 'rowCount' by 'columnCount' tiles into 'core' and hands the board 'core'
+    // held back to be reset. Returns false, leaving 'core' alone, if no board of that size is ready;
+    // a different size from the one being kept ready switches the queue to it for the next restarts.
+    bool take(int rowCount, int columnCount, BoardCore& core);
+
+    // Returns the number of boards ready to be taken.
+    size_t readyCount();
+};
@@ -0,0 +1,229 @@
+#include "chunkedBoard.h"
+#include <algorithm>
+#include <cstring>
+
+// ChunkedBoard constructor: no chunk is built until a tile is asked for
+ChunkedBoard::ChunkedBoard(uint64_t seed, double density, size_t maxResidentChunks)
+    : maxResidentChunks(max(maxResidentChunks, MIN_RESIDENT_CHUNKS)), seed(seed) {
+    density = max(ENDLESS_MIN_DENSITY, min(ENDLESS_MAX_DENSITY, density));
+    mineThreshold = (uint64_t)(density * 18446744073709551616.0); // density * 2^64
+}
+
+// Copies everything but the cache, which would point into the other board's chunks
+ChunkedBoard::ChunkedBoard(const ChunkedBoard& other)
+    : chunks(other.chunks), archive(other.archive), maxResidentChunks(other.maxResidentChunks), seed(other.seed),
+      mineThreshold(other.mineThreshold), useClock(other.useClock), started(other.started), safeColumn(other.safeColumn),
+      safeRow(other.safeRow), revealedSafeTiles(other.revealedSafeTiles), flagsPlaced(other.flagsPlaced), loser(other.loser),
+      enabled(other.enabled), chunksBuilt(other.chunksBuilt), chunksEvicted(other.chunksEvicted) {}
+
+// Assignment through the copy constructor, for the same reason
+ChunkedBoard& ChunkedBoard::operator=(const ChunkedBoard& other) {
+    if (this != &other) {
+        ChunkedBoard copy(other);
+        chunks.swap(copy.chunks);
+        archive.swap(copy.archive);
+        maxResidentChunks = copy.maxResidentChunks;
+        seed = copy.seed;
+        mineThreshold = copy.mineThreshold;
+        useClock = copy.useClock;
+        cached = nullptr;
+        started = copy.started;
+        safeColumn = copy.safeColumn;
+        safeRow = copy.safeRow;
+        revealedSafeTiles = copy.revealedSafeTiles;
+        flagsPlaced = copy.flagsPlaced;
+        loser = copy.loser;
+        enabled = copy.enabled;
+        chunksBuilt = copy.chunksBuilt;
+        chunksEvicted = copy.chunksEvicted;
+    }
+    return *this;
+}
+
+// Hashes the seed and the tile's coordinates (SplitMix64 finalizer) and compares with the density.
+// The coordinates form a unique 64-bit key, so every tile gets an independent draw.
+bool ChunkedBoard::isMineAt(int column, int row) const {
+    if (started && column >= safeColumn - 1 && column <= safeColumn + 1 && row >= safeRow - 1 && row <= safeRow + 1) return false;
+    uint64_t z = seed + ((uint64_t)(uint32_t)column << 32 | (uint32_t)row) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return (z ^ (z >> 31)) < mineThreshold;
+}
+
+// Counts the mines among the 8 neighbors by hashing each of them
+int ChunkedBoard::nearbyMinesAt(int column, int row) const {
+    int count = 0;
+    for (int i = row - 1; i <= row + 1; i++) {
+        for (int j = column - 1; j <= column + 1; j++) {
+            if ((i != row || j != column) && isMineAt(j, i)) count++;
+        }
+    }
+    return count;
+}
+
+// Hashes the chunk's tiles plus a one-tile ring around it, so the counts on the chunk's edges come
+// out right without touching the neighboring chunks, then counts with a sliding three-column sum
+// like BoardCore::countNearbyMines, and finally puts back the marks of an archived chunk
+void ChunkedBoard::build(BoardChunk& chunk, int chunkColumn, int chunkRow) {
+    const int side = CHUNK_SIZE + 2;
+    uint8_t mines[side * side];
+    int firstColumn = chunkColumn * CHUNK_SIZE - 1;
+    int firstRow = chunkRow * CHUNK_SIZE - 1;
+    for (int i = 0; i < side; i++) {
+        for (int j = 0; j < side; j++) mines[i * side + j] = isMineAt(firstColumn + j, firstRow + i);
+    }
+
+    uint8_t sums[side];
+    for (int i = 0; i < CHUNK_SIZE; i++) {
+        const uint8_t* above = &mines[i * side];
+        for (int j = 0; j < side; j++) sums[j] = (uint8_t)(above[j] + above[j + side] + above[j + 2 * side]);
+
+        uint8_t* row = &chunk.state[i * CHUNK_SIZE];
+        for (int j = 0; j < CHUNK_SIZE; j++) {
+            bool mine = above[side + j + 1] != 0;
+            row[j] = mine ? TILE_MINE : (uint8_t)(sums[j] + sums[j + 1] + sums[j + 2]);
+        }
+    }
+
+    auto archived = archive.find(chunkKey(chunkColumn, chunkRow));
+    if (archived != archive.end()) {
+        for (int i = 0; i < CHUNK_TILES; i++) {
+            if (archived->second.revealed[i / 64] >> (i % 64) & 1) chunk.state[i] |= TILE_REVEALED;
+        }
+        for (uint16_t i : archived->second.flagged) chunk.state[i] |= TILE_FLAGGED;
+        archive.erase(archived);
+    }
+    chunksBuilt++;
+}
+
+// Finds the chunk used longest ago (a scan of the resident chunks, which is small next to the
+// thousands of hashes that building a chunk costs) and keeps its marks if it has any
+void ChunkedBoard::evictLeastRecentlyUsed() {
+    auto oldest = chunks.begin();
+    for (auto it = chunks.begin(); it != chunks.end(); ++it) {
+        if (it->second.lastUsed < oldest->second.lastUsed) oldest = it;
+    }
+    if (&oldest->second == cached) cached = nullptr;
+
+    ChunkArchive marks;
+    memset(marks.revealed, 0, sizeof(marks.revealed));
+    bool explored = false;
+    const uint8_t* state = oldest->second.state;
+    for (int i = 0; i < CHUNK_TILES; i++) {
+        if (state[i] & TILE_REVEALED) marks.revealed[i / 64] |= 1ull << (i % 64);
+        if (state[i] & TILE_FLAGGED) marks.flagged.push_back((uint16_t)i);
+        explored = explored || (state[i] & (TILE_REVEALED | TILE_FLAGGED));
+    }
+    if (explored) archive[oldest->first] = move(marks);
+
+    chunks.erase(oldest);
+    chunksEvicted++;
+}
+
+// Looks the chunk up (the last one is cached, since neighboring tiles are mostly in the same chunk)
+BoardChunk& ChunkedBoard::chunk(int chunkColumn, int chunkRow) {
+    uint64_t key = chunkKey(chunkColumn, chunkRow);
+    if (cached && key == cachedKey) return *cached;
+
+    auto found = chunks.find(key);
+    if (found == chunks.end()) {
+        if (chunks.size() >= maxResidentChunks) evictLeastRecentlyUsed();
+        found = chunks.emplace(key, BoardChunk()).first;
+        build(found->second, chunkColumn, chunkRow);
+    }
+    found->second.lastUsed = ++useClock;
+    cachedKey = key;
+    cached = &found->second;
+    return *cached;
+}
+
+// Splits the coordinates into a chunk and a position inside it
+uint8_t& ChunkedBoard::tile(int column, int row) {
+    int chunkColumn = chunkOf(column);
+    int chunkRow = chunkOf(row);
+    BoardChunk& owner = chunk(chunkColumn, chunkRow);
+    return owner.state[(row - chunkRow * CHUNK_SIZE) * CHUNK_SIZE + (column - chunkColumn * CHUNK_SIZE)];
+}
+
+// Returns a tile's state with the board-wide enabled bit added
+uint8_t ChunkedBoard::tileAt(int column, int row) {
+    if (!inWorld(column, row)) return 0;
+    return tile(column, row) | (enabled ? TILE_ENABLED : 0);
+}
+
+// Breadth-first flood fill over coordinates, so it crosses chunk borders like any other step
+long long ChunkedBoard::reveal(int column, int row) {
+    if (loser || !inWorld(column, row) || (tile(column, row) & TILE_FLAGGED)) return 0;
+
+    // The first reveal fixes the safe start; chunks built before it (drawn frames, flags) hashed
+    // their mines without it, so they are rebuilt around the marks already on them
+    if (!started) {
+        started = true;
+        safeColumn = column;
+        safeRow = row;
+        for (auto& resident : chunks) {
+            uint8_t marks[CHUNK_TILES];
+            for (int i = 0; i < CHUNK_TILES; i++) marks[i] = resident.second.state[i] & (TILE_REVEALED | TILE_FLAGGED);
+            build(resident.second, (int)(uint32_t)(resident.first >> 32), (int)(uint32_t)resident.first);
+            for (int i = 0; i < CHUNK_TILES; i++) resident.second.state[i] |= marks[i];
+            chunksBuilt--; // A rebuild in place is not a new chunk
+        }
+    }
+
+    if (tile(column, row) & TILE_MINE) {
+        loser = true; // The player clicked a mine
+        return 0;
+    }
+
+    vector<pair<int, int>> revealedTiles; // Doubles as the worklist, like BoardCore::reveal
+    uint8_t& first = tile(column, row);
+    if (!(first & TILE_REVEALED)) {
+        first |= TILE_REVEALED;
+        revealedTiles.emplace_back(column, row);
+    }
+
+    // Reveals the hidden, unflagged neighbors of an empty tile and queues them
+    auto expand = [&](int x, int y) {
+        if ((tile(x, y) & TILE_COUNT_MASK) != 0) return;
+        for (int i = y - 1; i <= y + 1; i++) {
+            for (int j = x - 1; j <= x + 1; j++) {
+                if ((i == y && j == x) || !inWorld(j, i)) continue;
+                uint8_t& neighbor = tile(j, i);
+                if (!(neighbor & (TILE_REVEALED | TILE_FLAGGED))) {
+                    neighbor |= TILE_REVEALED;
+                    revealedTiles.emplace_back(j, i);
+                }
+            }
+        }
+    };
+
+    // The clicked tile is expanded even if it was already revealed; the fill stops expanding after
+    // ENDLESS_REVEAL_LIMIT tiles and leaves the rest of the region for the next click
+    size_t next = revealedTiles.size();
+    expand(column, row);
+    while (next < revealedTiles.size() && revealedTiles.size() < (size_t)ENDLESS_REVEAL_LIMIT) {
+        expand(revealedTiles[next].first, revealedTiles[next].second);
+        next++;
+    }
+
+    revealedSafeTiles += (long long)revealedTiles.size(); // Empty tiles never border a mine, so every tile revealed here is safe
+    return (long long)revealedTiles.size();
+}
+
+// Toggles the flag on a hidden tile while the game is running
+bool ChunkedBoard::toggleFlag(int column, int row) {
+    if (loser || !inWorld(column, row)) return false;
+    uint8_t& state = tile(column, row);
+    if (state & TILE_REVEALED) return false;
+
+    state ^= TILE_FLAGGED;
+    flagsPlaced += (state & TILE_FLAGGED) ? 1 : -1;
+    return true;
+}
+
+// Resident chunks plus archives, with a rough allowance for the hash map nodes
+size_t ChunkedBoard::memoryBytes() const {
+    size_t bytes = chunks.size() * (sizeof(BoardChunk) + 32) + archive.size() * (sizeof(ChunkArchive) + 32);
+    for (const auto& archived : archive) bytes += archived.second.flagged.capacity() * sizeof(uint16_t);
+    return bytes;
+}
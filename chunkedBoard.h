@@ -0,0 +1,120 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <utility>
+#include <unordered_map>
+#include "boardCore.h"
+using namespace std;
+
+const int CHUNK_SIZE = 64;                         // Width and height of a chunk in tiles.
+const int CHUNK_TILES = CHUNK_SIZE * CHUNK_SIZE;   // Number of tiles in a chunk.
+const size_t DEFAULT_RESIDENT_CHUNKS = 1024;       // Default cap on resident chunks (about 4 MB of tile state).
+const size_t MIN_RESIDENT_CHUNKS = 16;             // Smallest cap accepted (a few screens of chunks).
+const double ENDLESS_MIN_DENSITY = 0.12;           // Below about 10% the empty regions never end and a flood fill could run forever.
+const double ENDLESS_MAX_DENSITY = 0.9;            // Above this nearly every tile is a mine.
+const int ENDLESS_REVEAL_LIMIT = 1 << 20;          // Most tiles one reveal flood-fills (the rest of the region opens on the next click).
+const int ENDLESS_HALF_EXTENT = 1 << 30;           // Tiles are addressed from -2^30 to 2^30 - 1 on both axes.
+
+// The BoardChunk struct is one resident 64x64 square of an endless board.
+struct BoardChunk {
+    uint8_t state[CHUNK_TILES]; // Packed tile states (TILE_* bits, without TILE_ENABLED), row-major.
+    uint64_t lastUsed = 0;      // Use tick of the last access, for the least-recently-used eviction.
+};
+
+// The ChunkArchive struct keeps the player's marks on an evicted chunk. The mines and counts are
+// not kept: they are rebuilt from the seed when the chunk is needed again.
+struct ChunkArchive {
+    uint64_t revealed[CHUNK_TILES / 64]; // One bit per tile, row-major.
+    vector<uint16_t> flagged;             // Chunk-local indices of the flagged tiles (usually few).
+};
+
+// The ChunkedBoard class is a Minesweeper board with no edges. Whether a tile holds a mine is a
+// hash of the seed and the tile's coordinates compared with the mine density, so any tile's mine,
+// and the mine count of a tile on a chunk edge, is known without building the chunk next to it.
+// Chunks of 64x64 tiles are built when a reveal, a flag or a drawn frame reaches them, and once
+// more than 'maxResidentChunks' are resident the least recently used one is evicted: explored
+// chunks leave their revealed and flagged tiles behind in a compact archive (about 512 bytes)
+// and unexplored ones leave nothing, so memory follows the explored area, not the distance
+// travelled. Columns grow to the right and rows downwards from tile (0, 0), both may be negative.
+class ChunkedBoard {
+    // Private member variables:
+    unordered_map<uint64_t, BoardChunk> chunks;    // Resident chunks keyed by chunkKey().
+    unordered_map<uint64_t, ChunkArchive> archive; // Player marks of evicted explored chunks.
+    size_t maxResidentChunks;    // Cap on the number of resident chunks.
+    uint64_t seed;               // Seed the mines are hashed from.
+    uint64_t mineThreshold;      // Hashes below this value are mines (density * 2^64).
+    uint64_t useClock = 0;       // Tick counter for the least-recently-used order.
+    uint64_t cachedKey = 0;      // Key of the chunk accessed last.
+    BoardChunk* cached = nullptr; // Chunk accessed last (map nodes stay put, so the pointer survives rehashing).
+    bool started = false;        // Indicates whether the first reveal has chosen the safe start.
+    int safeColumn = 0;          // Column of the first revealed tile (it and its neighbors hold no mine).
+    int safeRow = 0;             // Row of the first revealed tile.
+
+    // Returns the map key of a chunk.
+    static uint64_t chunkKey(int chunkColumn, int chunkRow) { return (uint64_t)(uint32_t)chunkColumn << 32 | (uint32_t)chunkRow; }
+
+    // Fills in the mines and counts of a chunk from the hash and restores its archived marks.
+    void build(BoardChunk& chunk, int chunkColumn, int chunkRow);
+
+    // Archives (or drops) the least recently used resident chunk.
+    void evictLeastRecentlyUsed();
+
+    // Returns the resident chunk, building it (and evicting another) if needed.
+    BoardChunk& chunk(int chunkColumn, int chunkRow);
+
+    // Returns the state byte of a tile, building its chunk if needed. The reference is only valid
+    // until the next call, which may evict the chunk.
+    uint8_t& tile(int column, int row);
+
+public:
+    // Running counters over the whole board, including evicted chunks.
+    long long revealedSafeTiles = 0; // Number of revealed tiles that are not mines.
+    long long flagsPlaced = 0;       // Number of flagged tiles.
+    bool loser = false;              // Indicates whether a mine was revealed.
+    bool enabled = true;             // Indicates whether the tiles are interactable (reported in tileAt).
+    size_t chunksBuilt = 0;          // Chunks built so far (including rebuilds of evicted chunks).
+    size_t chunksEvicted = 0;        // Chunks evicted so far.
+
+    // Constructor: an endless board whose mines come from 'seed', with about 'density' of the tiles
+    // mines (clamped to ENDLESS_MIN_DENSITY - ENDLESS_MAX_DENSITY) and at most 'maxResidentChunks' chunks in memory.
+    ChunkedBoard(uint64_t seed = 0, double density = 0.2, size_t maxResidentChunks = DEFAULT_RESIDENT_CHUNKS);
+
+    // Copies leave the last-access cache behind (it points into the source's chunks).
+    ChunkedBoard(const ChunkedBoard& other);
+    ChunkedBoard& operator=(const ChunkedBoard& other);
+
+    // Returns the chunk holding a tile coordinate (rounding towards negative infinity).
+    static int chunkOf(int coordinate) { return coordinate >= 0 ? coordinate / CHUNK_SIZE : (coordinate + 1) / CHUNK_SIZE - 1; }
+
+    // Returns whether a tile is inside the addressable world.
+    static bool inWorld(int column, int row) {
+        return column >= -ENDLESS_HALF_EXTENT && column < ENDLESS_HALF_EXTENT && row >= -ENDLESS_HALF_EXTENT && row < ENDLESS_HALF_EXTENT;
+    }
+
+    // Returns whether a tile holds a mine, straight from the hash (no chunk is built).
+    bool isMineAt(int column, int row) const;
+
+    // Returns the number of mines around a tile, straight from the hash (no chunk is built).
+    int nearbyMinesAt(int column, int row) const;
+
+    // Returns the packed state of a tile (TILE_* bits), building its chunk if needed.
+    uint8_t tileAt(int column, int row);
+
+    // Reveals a tile and flood-fills the empty region around it, across chunk borders.
+    // The first reveal keeps that tile and its neighbors clear of mines; revealing a mine loses
+    // the game. Returns the number of tiles revealed. Does nothing once the game is lost.
+    long long reveal(int column, int row);
+
+    // Toggles the flag on a hidden tile and returns whether anything changed.
+    bool toggleFlag(int column, int row);
+
+    // Returns whether the first reveal has happened.
+    bool hasStarted() const { return started; }
+
+    // Returns the number of chunks in memory and of archived explored chunks.
+    size_t residentChunks() const { return chunks.size(); }
+    size_t archivedChunks() const { return archive.size(); }
+
+    // Returns an estimate of the bytes held by resident chunks and archives.
+    size_t memoryBytes() const;
+};
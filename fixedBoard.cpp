@@ -0,0 +1,16 @@
+#include "fixedBoard.h"
+
+// The standard board sizes (rows, columns)
+template class FixedBoardCore<9, 9>;   // Beginner
+template class FixedBoardCore<16, 16>; // Intermediate
+template class FixedBoardCore<16, 30>; // Expert
+template class FixedBoardCore<16, 25>; // Default files/config.cfg
+
+// Picks the compiled kernels for a standard size, or the dynamic kernels for any other
+const BoardKernels* selectBoardKernels(int rows, int columns) {
+    if (rows == 9 && columns == 9) return &FixedBoardCore<9, 9>::kernels;
+    if (rows == 16 && columns == 16) return &FixedBoardCore<16, 16>::kernels;
+    if (rows == 16 && columns == 30) return &FixedBoardCore<16, 30>::kernels;
+    if (rows == 16 && columns == 25) return &FixedBoardCore<16, 25>::kernels;
+    return &DYNAMIC_BOARD_KERNELS;
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "boardCore.h"
+using namespace std;
+
+// Board kernels compiled for one board size. The standard sizes have one each: beginner (9x9),
+// intermediate (16x16), expert (16 rows x 30 columns) and the default files/config.cfg board
+// (16 rows x 25 columns). With the size known at compile time, the neighbor offsets are constants
+// and the edge handling of a tile is one lookup in a table of border masks built by the compiler,
+// instead of the four row and column comparisons BoardCore::forEachNeighbor makes for every tile.
+// BoardCore::resize picks these kernels when the size matches; other sizes use the dynamic ones.
+
+// Number of neighbors of a tile, in the order of the neighbor offsets (row above, left to right;
+// left and right; row below, left to right), which is also the order forEachNeighbor visits them.
+const int NEIGHBOR_DIRECTIONS = 8;
+const uint8_t ALL_NEIGHBORS = 0xFF; // Border mask of a tile away from the edges.
+
+// The BorderMasks struct holds one byte per tile of a ROWS x COLUMNS board: bit k is set when
+// neighbor k of the tile is on the board.
+template <int ROWS, int COLUMNS>
+struct BorderMasks {
+    uint8_t mask[ROWS * COLUMNS];
+};
+
+// Builds the border masks of a ROWS x COLUMNS board (evaluated by the compiler)
+template <int ROWS, int COLUMNS>
+constexpr BorderMasks<ROWS, COLUMNS> makeBorderMasks() {
+    BorderMasks<ROWS, COLUMNS> table{};
+    for (int i = 0; i < ROWS; i++) {
+        for (int j = 0; j < COLUMNS; j++) {
+            uint8_t mask = 0;
+            int bit = 0;
+            for (int rowStep = -1; rowStep <= 1; rowStep++) {
+                for (int columnStep = -1; columnStep <= 1; columnStep++) {
+                    if (rowStep == 0 && columnStep == 0) continue;
+                    bool onBoard = i + rowStep >= 0 && i + rowStep < ROWS && j + columnStep >= 0 && j + columnStep < COLUMNS;
+                    if (onBoard) mask |= (uint8_t)(1 << bit);
+                    bit++;
+                }
+            }
+            table.mask[i * COLUMNS + j] = mask;
+        }
+    }
+    return table;
+}
+
+// The FixedBoardCore class holds the kernels of a ROWS x COLUMNS board. It works on the tiles
+// of a BoardCore (same flat, row-major state bytes and counters), so a fixed-size board is an
+// ordinary BoardCore whose 'kernels' point here, and the results match the dynamic kernels
+// exactly (same tiles, revealed in the same order).
+template <int ROWS, int COLUMNS>
+class FixedBoardCore {
+public:
+    static constexpr int TILES = ROWS * COLUMNS;
+
+    // Index distance to each neighbor, in NEIGHBOR_DIRECTIONS order.
+    static constexpr int neighborOffsets[NEIGHBOR_DIRECTIONS] = {
+        -COLUMNS - 1, -COLUMNS, -COLUMNS + 1, -1, 1, COLUMNS - 1, COLUMNS, COLUMNS + 1};
+
+    // Which neighbors of each tile are on the board.
+    static constexpr BorderMasks<ROWS, COLUMNS> borderMasks = makeBorderMasks<ROWS, COLUMNS>();
+
+    // Calls visit(neighborIndex) for each of the up to 8 tiles around 'index', in the same order as
+    // BoardCore::forEachNeighbor. Tiles away from the edges (most of them) skip the mask tests.
+    template <typename Visit>
+    static void forEachNeighbor(int index, Visit visit) {
+        unsigned mask = borderMasks.mask[index];
+        if (mask == ALL_NEIGHBORS) {
+            for (int k = 0; k < NEIGHBOR_DIRECTIONS; k++) visit(index + neighborOffsets[k]);
+            return;
+        }
+        for (int k = 0; k < NEIGHBOR_DIRECTIONS; k++) {
+            if (mask & (1u << k)) visit(index + neighborOffsets[k]);
+        }
+    }
+
+    // Kernels (see BoardCore::reveal, countNearbyMines and countRevealedSafeTiles).
+    static void reveal(BoardCore& core, int index, vector<int>& revealedTiles);
+    static void countNearbyMines(BoardCore& core);
+    static int countRevealedSafeTiles(const BoardCore& core);
+
+    static const BoardKernels kernels; // The three kernels above, for BoardCore::kernels.
+};
+
+template <int ROWS, int COLUMNS>
+constexpr int FixedBoardCore<ROWS, COLUMNS>::neighborOffsets[NEIGHBOR_DIRECTIONS];
+
+template <int ROWS, int COLUMNS>
+constexpr BorderMasks<ROWS, COLUMNS> FixedBoardCore<ROWS, COLUMNS>::borderMasks;
+
+// Reveals with the border-mask neighbor walk
+template <int ROWS, int COLUMNS>
+void FixedBoardCore<ROWS, COLUMNS>::reveal(BoardCore& core, int index, vector<int>& revealedTiles) {
+    core.revealWith(index, revealedTiles, [](int tile, auto visit) { forEachNeighbor(tile, visit); });
+}
+
+// Counts nearby mines with constant loop bounds and the scratch rows on the stack
+template <int ROWS, int COLUMNS>
+void FixedBoardCore<ROWS, COLUMNS>::countNearbyMines(BoardCore& core) {
+    uint8_t columnMines[COLUMNS + 2] = {};
+    static const uint8_t emptyRow[COLUMNS] = {};
+    BoardCore::countNearbyMinesWith(core.state.data(), integral_constant<int, ROWS>(), integral_constant<int, COLUMNS>(), columnMines, emptyRow);
+}
+
+// Counts the revealed safe tiles with a constant trip count
+template <int ROWS, int COLUMNS>
+int FixedBoardCore<ROWS, COLUMNS>::countRevealedSafeTiles(const BoardCore& core) {
+    return BoardCore::countRevealedSafeTilesWith(core.state.data(), integral_constant<int, TILES>());
+}
+
+template <int ROWS, int COLUMNS>
+const BoardKernels FixedBoardCore<ROWS, COLUMNS>::kernels = {reveal, countNearbyMines, countRevealedSafeTiles, ROWS, COLUMNS};
+
+// The standard sizes are compiled once, in fixedBoard.cpp.
+extern template class FixedBoardCore<9, 9>;
+extern template class FixedBoardCore<16, 16>;
+extern template class FixedBoardCore<16, 30>;
+extern template class FixedBoardCore<16, 25>;
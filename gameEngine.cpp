@@ -0,0 +1,151 @@
+#include "gameEngine.h"
+#include "trace.h"
+#include <fstream>
+#include <cassert>
+
+// Reads the board settings (columns, rows and mines, one per line, then an optional generation mode) from a config file
+BoardConfig readBoardConfig(const string& path) {
+    BoardConfig config;
+    fstream boardConfig(path); // Open and read the configuration file
+
+    // Read the number of columns from the first line
+    string columnInfoString;
+    getline(boardConfig, columnInfoString);
+    config.columns = stoi(columnInfoString);
+
+    // Read the number of rows from the second line
+    string rowInfoString;
+    getline(boardConfig, rowInfoString);
+    config.rows = stoi(rowInfoString);
+
+    // Read the number of mines from the third line
+    string mineCountInfoString;
+    getline(boardConfig, mineCountInfoString);
+    config.mineCount = stoi(mineCountInfoString);
+
+    // Read the optional generation mode from the fourth line
+    string generationModeString;
+    if (getline(boardConfig, generationModeString) && !generationModeString.empty() && generationModeString != "\r") {
+        config.generationMode = stoi(generationModeString);
+    }
+
+    return config;
+}
+
+// Mixes the base seed and stream number so that neighboring streams start far apart
+uint32_t streamSeed(uint64_t baseSeed, uint64_t stream) {
+    uint64_t z = baseSeed + (stream + 1) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return (uint32_t)((z ^ (z >> 31)) >> 32);
+}
+
+// GameEngine constructor: initializes an empty game board of the given size and mine count
+GameEngine::GameEngine(const BoardConfig& config, uint32_t seed) {
+    restart(config, seed);
+}
+
+// Sets up a new game over the existing tile storage
+void GameEngine::restart(const BoardConfig& config, uint32_t seed, BoardQueue* queue) {
+    TRACE_SCOPE("GameEngine::restart");
+    this->seed = seed;
+    rng.seed(seed);
+    this->columns = config.columns;
+    this->rows = config.rows;
+
+    // Calculate the total number of tiles (rows × columns)
+    this->tiles = this->rows * this->columns;
+
+    this->mineCount = min(config.mineCount, tiles - 1); // At least the first clicked tile must be safe
+    this->generationMode = config.generationMode;
+
+    // The no-guess search seed is the first number drawn, so the random stream stays the same
+    // whether the search is run or its logged outcome is replayed
+    this->layoutCandidate = LAYOUT_UNDECIDED;
+    this->layoutSearchSeed = generationMode == GENERATION_NO_GUESS && tiles < HUGE_BOARD_TILES ? rng() : 0;
+
+    // Initialize the remaining flags to place
+    this->placeFlagging = mineCount;
+
+    // Initialize game state flags
+    this->loser = false;
+    this->winner = false;
+
+    // Every tile in one flat buffer (hidden, enabled, no mines): a board from the queue, the same
+    // storage reset, or a new buffer when the size changed
+    if (queue && queue->take(rows, columns, core)) return;
+    if (core.rows == rows && core.columns == columns && (int)core.state.size() == tiles) core.reset();
+    else core.resize(rows, columns);
+
+    // Mines are placed on the first reveal, so the first clicked tile and its neighbors are never mines
+}
+
+// Reveals a tile, generating the board on the first reveal and updating the win/lose state
+void GameEngine::reveal(int index, vector<int>& revealedTiles) {
+    TRACE_SCOPE("GameEngine::reveal");
+    if (loser || winner || core.isFlagged(index)) return; // Game over, or a flagged tile
+
+    // The first reveal generates the board around the clicked tile
+    if (!core.minesPlaced) {
+        chooseLayout(index);
+        if (layoutCandidate >= 0) {
+            placeCandidateMines(core, mineCount, index, streamSeed(layoutSearchSeed, layoutCandidate));
+        } else {
+            core.placeMines(mineCount, rng, index); // Random layout (or no no-guess layout was found in time, or the board is huge)
+        }
+    }
+
+    if (core.isMine(index)) {
+        loser = true; // The player clicked a mine
+        return;
+    }
+
+    core.reveal(index, revealedTiles);
+
+    if (core.revealedSafeTiles == tiles - mineCount) {
+        winner = true;
+        placeFlagging = 0; // Reset flags as per the game instructions
+    }
+}
+
+// Runs the no-guess search once, before the first reveal places the mines
+bool GameEngine::chooseLayout(int index) {
+    if (loser || winner || core.minesPlaced || core.isFlagged(index) || layoutCandidate != LAYOUT_UNDECIDED) return false;
+    if (generationMode != GENERATION_NO_GUESS || tiles >= HUGE_BOARD_TILES) {
+        layoutCandidate = LAYOUT_RANDOM;
+        return false;
+    }
+
+    uint32_t layoutSeed;
+    GenerationReport report;
+    findNoGuessLayout(rows, columns, mineCount, index, layoutSearchSeed, layoutSeed, &report, 100000, noGuessBudgetMilliseconds);
+    layoutCandidate = report.found ? report.candidate : LAYOUT_RANDOM;
+    return true;
+}
+
+// Toggles the flag on a hidden tile while the game is running
+bool GameEngine::toggleFlag(int index) {
+    if (loser || winner || core.isRevealed(index)) return false;
+
+    core.toggleFlag(index);
+    placeFlagging = mineCount - core.flagsPlaced; // One flag fewer (or more) left to place
+    return true;
+}
+
+// Disables all tiles on the board
+void GameEngine::disableTiles() {
+    core.setAllEnabled(false);
+}
+
+// Enables all tiles on the board
+void GameEngine::enableAllTiles() {
+    core.setAllEnabled(true);
+}
+
+// Checks if the player has won the game using the running revealed-tile counter
+bool GameEngine::checkIfWinner() {
+    TRACE_SCOPE("GameEngine::checkIfWinner");
+    assert(tiles >= HUGE_BOARD_TILES || core.countersMatchScan()); // Debug builds verify the counters against a full scan (too slow per frame on huge boards)
+    return winner;
+}
+
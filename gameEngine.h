@@ -0,0 +1,88 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <random>
+#include "boardCore.h"
+#include "boardGenerator.h"
+#include "boardQueue.h"
+using namespace std;
+
+// The BoardConfig struct holds the board settings stored in files/config.cfg.
+struct BoardConfig {
+    int columns;   // Number of columns in the board.
+    int rows;      // Number of rows in the board.
+    int mineCount; // Total number of mines on the board.
+    int generationMode = GENERATION_RANDOM; // How the mines are laid out (GENERATION_* value).
+};
+
+// Reads the board settings (columns, rows and mines, one per line, then an optional
+// generation mode: 0 for random layouts, 1 for no-guess layouts, 2 for an endless board) from a config file.
+BoardConfig readBoardConfig(const string& path = "files/config.cfg");
+
+// Derives the seed of random stream number 'stream' from a base seed (SplitMix64 mixing), so
+// threads and games can each own an independent generator and still be reproducible.
+uint32_t streamSeed(uint64_t baseSeed, uint64_t stream);
+
+// Values of GameEngine::layoutCandidate that aren't a no-guess candidate number.
+const int LAYOUT_UNDECIDED = -2; // The first reveal hasn't chosen its layout yet.
+const int LAYOUT_RANDOM = -1;    // The first reveal lays out the mines at random.
+
+// Wall-clock time the no-guess search may take on the first reveal before it falls back to a
+// random layout; the reveal runs on the game thread, and some boards have no passing layout.
+const double NO_GUESS_BUDGET_MILLISECONDS = 150;
+
+// The GameEngine class runs one game of Minesweeper with no graphics at all.
+// It owns the board generation, reveal and flag rules, the win/lose state and the
+// counters, so simulations, benchmarks and servers can use it without SFML.
+class GameEngine {
+public:
+    // Variables:
+    int rows;          // Number of rows in the board.
+    int columns;       // Number of columns in the board.
+    int tiles;         // Total number of tiles.
+    int placeFlagging; // Number of flags available for placement (may go negative).
+    int mineCount;     // Total number of mines on the board.
+    int generationMode; // How the mines are laid out on the first reveal (GENERATION_* value).
+    BoardCore core;    // Flat, row-major storage of every tile's packed state.
+    bool loser;        // Indicates if the game is lost.
+    bool winner;       // Indicates if the game is won.
+    uint32_t seed;     // Seed the game was created with (the same seed gives the same boards).
+    mt19937 rng;       // Random number generator used to place the mines.
+    uint32_t layoutSearchSeed; // Base seed of the no-guess candidate layouts (drawn from 'rng' when a no-guess game starts).
+    int layoutCandidate;       // No-guess candidate the first reveal lays out, or a LAYOUT_* value.
+    double noGuessBudgetMilliseconds = NO_GUESS_BUDGET_MILLISECONDS; // Time limit of the no-guess search (0 for none).
+
+    // Methods:
+    // Parameterized constructor: Initializes an empty board; the mines are placed on the first reveal.
+    GameEngine(const BoardConfig& config, uint32_t seed);
+
+    // Starts a new game in this engine, exactly as if it had been built with 'config' and 'seed'.
+    // The tiles are reset in place when the size is unchanged, or swapped for a ready board from
+    // 'queue' when it has one, so a restart doesn't free and allocate every tile.
+    void restart(const BoardConfig& config, uint32_t seed, BoardQueue* queue = nullptr);
+
+    // Reveals the tile at 'index' and appends every newly revealed tile to 'revealedTiles'.
+    // The first reveal places the mines around the clicked tile (in no-guess mode, a layout the
+    // solver clears from that tile without guessing, except on huge boards), revealing a mine loses the
+    // game, and revealing the last safe tile wins it. Does nothing once the game is over.
+    void reveal(int index, vector<int>& revealedTiles);
+
+    // Chooses the layout the first reveal at 'index' will use, unless it is chosen already or that
+    // reveal wouldn't place the mines: in no-guess mode, the lowest candidate the search finds
+    // within the time limit (LAYOUT_RANDOM if none), otherwise LAYOUT_RANDOM. Returns whether a
+    // no-guess search ran. Its outcome depends on timing, so game logs record it (EVENT_LAYOUT)
+    // and the replayer sets 'layoutCandidate' from the log instead of searching.
+    bool chooseLayout(int index);
+
+    // Toggles the flag on a hidden tile and returns whether anything changed.
+    bool toggleFlag(int index);
+
+    // Disables all tiles, preventing interactions.
+    void disableTiles();
+
+    // Enables all tiles, allowing interactions.
+    void enableAllTiles();
+
+    // Checks if the player has won the game.
+    bool checkIfWinner();
+};
@@ -1,251 +1,590 @@
 #include "gameHelp.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
 #include <random>
-#include <fstream>
-
-// Constructor for the Tile class
-// Initializes the tile's coordinates, textures, and state
-Tile::Tile(int xcoord, int ycoord) {
-    // Load textures for various tile states
-    tileHidden.loadFromFile("files/images/tile_hidden.png");
-    revealedTileTexture.loadFromFile("files/images/tile_revealed.png");
-    mineTexture.loadFromFile("files/images/mine.png");
-    textureWithFlag.loadFromFile("files/images/flag.png");
-    textureOne.loadFromFile("files/images/number_1.png");
-    textureTwo.loadFromFile("files/images/number_2.png");
-    textureThree.loadFromFile("files/images/number_3.png");
-    textureFour.loadFromFile("files/images/number_4.png");
-    textureFive.loadFromFile("files/images/number_5.png");
-    textureSix.loadFromFile("files/images/number_6.png");
-    textureSeven.loadFromFile("files/images/number_7.png");
-    textureEight.loadFromFile("files/images/number_8.png");
-
-    // Set default tile properties
-    this->nearbyMines = 0; // Number of adjacent mines
-    this->sprite.setPosition(xcoord * 32, ycoord * 32); // Position on the game board
-    tile_flagged = false;  // Initially not flagged
-    tile_mine = false;     // Initially not a mine
-    tile_revealed = false; // Initially hidden
-    tile_enabled = true;   // Initially active
-}
-
-// Render the tile based on its current state and game conditions
-void Tile::draw(RenderWindow& window, bool is_debugMode, bool is_paused, bool leaderBoard, bool loser, bool winner) {
-    if (is_debugMode && tile_mine) {
-        // In debug mode, display mines even if hidden
-        this->sprite.setTexture(tileHidden);
-        window.draw(this->sprite);
-
-        if (tile_flagged) {
-            // Show flagged mines
-            this->sprite.setTexture(textureWithFlag);
-            window.draw(this->sprite);
-        }
 
-        this->sprite.setTexture(mineTexture);
-        window.draw(this->sprite);
-    } else if (is_debugMode && !tile_mine) {
-        // In debug mode, display hidden or revealed non-mines
-        if (!tile_revealed && !tile_flagged) {
-            // Hidden and not flagged
-            this->sprite.setTexture(tileHidden);
-            window.draw(this->sprite);
-        } else if (!tile_revealed && tile_flagged) {
-            // Hidden but flagged
-            this->sprite.setTexture(tileHidden);
-            window.draw(this->sprite);
-
-            this->sprite.setTexture(textureWithFlag);
-            window.draw(this->sprite);
-        } else if (tile_revealed && nearbyMines == 0) {
-            // Revealed with no adjacent mines
-            this->sprite.setTexture(revealedTileTexture);
-            window.draw(this->sprite);
-        } else {
-            // Revealed with adjacent mines, display corresponding number texture
-            this->sprite.setTexture(revealedTileTexture);
-            window.draw(this->sprite);
-
-            switch (nearbyMines) {
-                case 1: this->sprite.setTexture(textureOne); break;
-                case 2: this->sprite.setTexture(textureTwo); break;
-                case 3: this->sprite.setTexture(textureThree); break;
-                case 4: this->sprite.setTexture(textureFour); break;
-                case 5: this->sprite.setTexture(textureFive); break;
-                case 6: this->sprite.setTexture(textureSix); break;
-                case 7: this->sprite.setTexture(textureSeven); break;
-                case 8: this->sprite.setTexture(textureEight); break;
-            }
-            window.draw(this->sprite);
-        }
-    } else if (loser && tile_mine) {
-        // Show all mines when the player loses
-        this->sprite.setTexture(revealedTileTexture);
-        window.draw(this->sprite);
+// Returns the process-wide texture cache (created on first use)
+TextureCache& TextureCache::instance() {
+    static TextureCache cache;
+    return cache;
+}
 
-        if (tile_flagged) {
-            // Flagged mines
-            this->sprite.setTexture(textureWithFlag);
-            window.draw(this->sprite);
-        }
+// Returns the texture stored under 'path', loading it the first time it is requested
+const Texture& TextureCache::get(const string& path) {
+    auto found = textures.find(path);
+    if (found != textures.end()) return found->second; // Already loaded, reuse it
 
-        this->sprite.setTexture(mineTexture);
-        window.draw(this->sprite);
-    } else if (winner && tile_mine) {
-        // Show all flagged mines when the player wins
-        this->sprite.setTexture(tileHidden);
-        window.draw(this->sprite);
+    TRACE_SCOPE("TextureCache::load");
+    Texture& texture = textures[path]; // Insert a new texture into the cache
+    if (!texture.loadFromFile(path)) {
+        cout << "Failed to load texture " << path << endl;
+    }
+    return texture;
+}
 
-        this->sprite.setTexture(textureWithFlag);
-        window.draw(this->sprite);
-    } else {
-        // Handle other game states (general cases for hidden, revealed, flagged tiles)
-        if (!tile_revealed && !tile_flagged && tile_enabled) {
-            // Hidden and active tile
-            this->sprite.setTexture(tileHidden);
-            window.draw(this->sprite);
-        } else if (!tile_revealed && tile_flagged) {
-            // Hidden but flagged
-            this->sprite.setTexture(tileHidden);
-            window.draw(this->sprite);
-
-            this->sprite.setTexture(textureWithFlag);
-            window.draw(this->sprite);
-        } else if (tile_revealed) {
-            // Revealed tiles with surrounding mines
-            this->sprite.setTexture(revealedTileTexture);
-            window.draw(this->sprite);
-
-            if (nearbyMines > 0 && !tile_mine) {
-                switch (nearbyMines) {
-                    case 1: this->sprite.setTexture(textureOne); break;
-                    case 2: this->sprite.setTexture(textureTwo); break;
-                    case 3: this->sprite.setTexture(textureThree); break;
-                    case 4: this->sprite.setTexture(textureFour); break;
-                    case 5: this->sprite.setTexture(textureFive); break;
-                    case 6: this->sprite.setTexture(textureSix); break;
-                    case 7: this->sprite.setTexture(textureSeven); break;
-                    case 8: this->sprite.setTexture(textureEight); break;
-                }
-                window.draw(this->sprite);
-            }
+// Returns the tile atlas, composing every tile face from the tile images on first use
+const Texture& TextureCache::tileAtlas() {
+    if (!atlasLoaded) {
+        TRACE_SCOPE("TextureCache::tileAtlas");
+
+        // Load the layers that the tile faces are built from
+        Image hidden, revealed, mine, flag, numbers[9];
+        hidden.loadFromFile("files/images/tile_hidden.png");
+        revealed.loadFromFile("files/images/tile_revealed.png");
+        mine.loadFromFile("files/images/mine.png");
+        flag.loadFromFile("files/images/flag.png");
+        for (int i = 1; i <= 8; i++) {
+            numbers[i].loadFromFile("files/images/number_" + to_string(i) + ".png");
         }
 
-        if (is_paused) {
-            // Show revealed state when the game is paused
-            this->sprite.setTexture(revealedTileTexture);
-            window.draw(this->sprite);
+        // Start from a transparent sheet so FACE_BLANK draws nothing
+        Image sheet;
+        sheet.create(TILE_ATLAS_COLUMNS * TILE_SIZE, (FACE_COUNT / TILE_ATLAS_COLUMNS) * TILE_SIZE, Color::Transparent);
+
+        // Blends one layer on top of the given cell (layers are added bottom to top)
+        auto addLayer = [&sheet](int face, const Image& layer) {
+            sheet.copy(layer, (face % TILE_ATLAS_COLUMNS) * TILE_SIZE, (face / TILE_ATLAS_COLUMNS) * TILE_SIZE, IntRect(0, 0, 0, 0), true);
+        };
+
+        addLayer(FACE_HIDDEN, hidden);
+        addLayer(FACE_REVEALED, revealed);
+        addLayer(FACE_HIDDEN_FLAG, hidden);
+        addLayer(FACE_HIDDEN_FLAG, flag);
+        addLayer(FACE_HIDDEN_MINE, hidden);
+        addLayer(FACE_HIDDEN_MINE, mine);
+        addLayer(FACE_HIDDEN_FLAG_MINE, hidden);
+        addLayer(FACE_HIDDEN_FLAG_MINE, flag);
+        addLayer(FACE_HIDDEN_FLAG_MINE, mine);
+        addLayer(FACE_REVEALED_MINE, revealed);
+        addLayer(FACE_REVEALED_MINE, mine);
+        addLayer(FACE_REVEALED_FLAG_MINE, revealed);
+        addLayer(FACE_REVEALED_FLAG_MINE, flag);
+        addLayer(FACE_REVEALED_FLAG_MINE, mine);
+        for (int i = 1; i <= 8; i++) {
+            addLayer(FACE_NUMBER_1 + i - 1, revealed);
+            addLayer(FACE_NUMBER_1 + i - 1, numbers[i]);
         }
 
-        if (leaderBoard && !winner) {
-            // Show leaderboard view for non-winners
-            this->sprite.setTexture(revealedTileTexture);
-            window.draw(this->sprite);
-        }
+        atlas.loadFromImage(sheet);
+        atlasLoaded = true;
     }
+    return atlas;
 }
 
-// Toggles the flagged state of the tile
-void Tile::toggleFlag() {
-    this->tile_flagged = !this->tile_flagged; // Switch the flagged state (true to false or vice versa)
+// RenderScheduler constructor: the first frame is always drawn
+RenderScheduler::RenderScheduler(unsigned frameCap) {
+    startCpuTime = clock();
+    setFrameCap(frameCap);
 }
 
-// Random number generation utilities
-mt19937 random_mt; // Mersenne Twister random number generator
+// Converts the frame cap to the shortest time allowed between frames
+void RenderScheduler::setFrameCap(unsigned frameCap) {
+    minimumFrameTime = frameCap > 0 ? microseconds(1000000 / frameCap) : Time::Zero;
+}
 
-// Generates a random integer between 'min' and 'max' (inclusive)
-int Random(int min, int max) {
-    uniform_int_distribution<int> dist(min, max);
-    return dist(random_mt);
+// Redraws when the timer moves on to another second
+void RenderScheduler::timerShows(int second) {
+    if (second != shownTimerSecond) {
+        shownTimerSecond = second;
+        dirty = true;
+    }
 }
 
-// Board constructor: initializes the game board based on the config file
-Board::Board() {
-    // Open and read the configuration file
-    fstream boardConfig("files/config.cfg");
+// A frame is due when the content is out of date and the frame cap allows it
+bool RenderScheduler::shouldDraw() {
+    return dirty && frameClock.getElapsedTime() >= minimumFrameTime;
+}
+
+// Clears the dirty state and starts timing the next frame interval
+void RenderScheduler::frameDrawn() {
+    dirty = false;
+    framesDrawn++;
+    frameClock.restart();
+}
+
+// Picks the nearest deadline: a pending frame held back by the cap, or the timer's next second
+Time RenderScheduler::waitTime(bool timerRunning, Time timerElapsed) {
+    if (dirty) {
+        Time untilFrame = minimumFrameTime - frameClock.getElapsedTime();
+        return untilFrame > Time::Zero ? untilFrame : microseconds(1);
+    }
+    if (timerRunning) {
+        Time untilNextSecond = seconds((float)(shownTimerSecond + 1)) - timerElapsed;
+        return untilNextSecond > Time::Zero ? untilNextSecond : microseconds(1);
+    }
+    return Time::Zero;
+}
+
+// SFML 2.5 has no waitEvent with a timeout, so timed waits poll with short sleeps in between
+bool RenderScheduler::waitForEvent(Window &window, Event &event, Time timeout) {
+    TRACE_SCOPE("RenderScheduler::waitForEvent");
+    if (timeout == Time::Zero) return window.waitEvent(event); // Nothing scheduled: block
+
+    Clock waitClock;
+    while (!window.pollEvent(event)) {
+        Time remaining = timeout - waitClock.getElapsedTime();
+        if (remaining <= Time::Zero) return false;
+        sleep(remaining < milliseconds(2) ? remaining : milliseconds(2));
+    }
+    return true;
+}
+
+// Reports how many frames were drawn and how much of a core the process used
+void RenderScheduler::printReport(const string &windowName) {
+    double wallSeconds = lifetimeClock.getElapsedTime().asSeconds();
+    double cpuSeconds = (double)(clock() - startCpuTime) / CLOCKS_PER_SEC;
+    cout << windowName << ": " << framesDrawn << " frames in " << wallSeconds << " s ("
+         << (wallSeconds > 0 ? framesDrawn / wallSeconds : 0) << " fps), CPU "
+         << (wallSeconds > 0 ? 100.0 * cpuSeconds / wallSeconds : 0) << "%" << endl;
+}
+
+// TextWidget constructor: sets up the text once; it is laid out on the first draw
+TextWidget::TextWidget(const Font &font, unsigned size, Color color, Uint32 style, Vector2f centerPoint, const String &value)
+    : text(value, font, size), content(value), center(centerPoint) {
+    text.setFillColor(color);
+    text.setStyle(style);
+}
+
+// Only a different string invalidates the layout
+void TextWidget::setString(const String &value) {
+    if (value == content) return;
+    content = value;
+    text.setString(value);
+    layoutDirty = true;
+}
 
-    // Read the number of columns from the first line
-    string columnInfoString;
-    getline(boardConfig, columnInfoString);
-    this->columns = stoi(columnInfoString);
+// Centers the text on its anchor point when needed, then draws it
+void TextWidget::draw(RenderTarget &target) {
+    if (layoutDirty) {
+        FloatRect rectOfText = text.getLocalBounds();
+        text.setOrigin(rectOfText.left + rectOfText.width / 2.0f, rectOfText.top + rectOfText.height / 2.0f);
+        text.setPosition(center);
+        layoutDirty = false;
+    }
+    drawCounted(target, text);
+}
+
+int FrameOverlay::drawCalls = 0;
+
+// FrameOverlay constructor: small white text on a dark box
+FrameOverlay::FrameOverlay(const Font &font) {
+    text.setFont(font);
+    text.setCharacterSize(14);
+    text.setFillColor(Color::White);
+    text.setPosition(8, 6);
+    background.setPosition(4, 4);
+    background.setSize(Vector2f(330, 22));
+    background.setFillColor(Color(0, 0, 0, 170));
+}
+
+// Starts the frame's clock and draw-call count
+void FrameOverlay::frameStarted() {
+    frameClock.restart();
+    drawCalls = 0;
+}
+
+// Shows the frame's CPU time so far (everything but the readout and display()), then starts the event count over
+void FrameOverlay::draw(RenderTarget &target) {
+    double frameMilliseconds = frameClock.getElapsedTime().asMicroseconds() / 1000.0;
+    char readout[96];
+    snprintf(readout, sizeof(readout), "frame %.2f ms   %d draw calls   %d events", frameMilliseconds, drawCalls, events);
+    text.setString(readout);
+    events = 0;
+    target.draw(background);
+    target.draw(text);
+}
+
+// Random number generation utilities
+thread_local mt19937 random_mt(random_device{}()); // Mersenne Twister random number generator (one stream per thread)
 
-    // Read the number of rows from the second line
-    string rowInfoString;
-    getline(boardConfig, rowInfoString);
-    this->rows = stoi(rowInfoString);
+// Board constructor: initializes the game board based on the config file
+Board::Board() : Board(readBoardConfig()) {}
 
-    // Calculate the total number of tiles (rows × columns)
-    this->tiles = this->rows * this->columns;
+// Board constructor: initializes a game board of the given size and mine count with a fresh seed
+Board::Board(const BoardConfig& config) : Board(config, random_mt()) {}
 
-    // Read the number of mines from the third line
-    string mineCountInfoString;
-    getline(boardConfig, mineCountInfoString);
-    this->mineCount = stoi(mineCountInfoString);
+// Board constructor: initializes a game board of the given size and mine count from a seed
+Board::Board(const BoardConfig& config, uint32_t seed) : GameEngine(config, seed) {
+    startDisplay();
+}
 
-    // Initialize the remaining flags to place
-    this->placeFlagging = mineCount;
+// Restarts the engine over the same tiles (or a queued board), then the display modes and helpers
+void Board::restart(const BoardConfig& config, uint32_t seed, BoardQueue* queue) {
+    TRACE_SCOPE("Board::restart");
+    bool endlessBoard = config.generationMode == GENERATION_ENDLESS;
+    GameEngine::restart(config, seed, endlessBoard ? nullptr : queue);
+    startDisplay();
+    renderer.allTilesChanged(); // The quads are rewritten over the visible tiles, keeping the vertex array
+    minimap = Minimap();
+    solver = Solver(); // Starts over from the new board on its next solve()
+}
 
-    // Initialize game state flags
+// Initializes the display modes and, for the endless generation mode, the chunked board
+void Board::startDisplay() {
     this->is_debugMode = false;
     this->is_paused = false;
     this->leaderBoard = false;
-    this->loser = false;
-    this->winner = false;
-
-    // Create and initialize a 2D vector of tiles
-    for (unsigned i = 0; i < rows; i++) {
-        vector<Tile*> *currRow = new vector<Tile*>;
-        for (unsigned j = 0; j < columns; j++) {
-            Tile *tempPointer = new Tile(j, i); // Create a new tile
-            currRow->push_back(tempPointer);    // Add tile to the current row
-        }
-        boardPointer2D.push_back(currRow); // Add row to the board
+
+    // An endless board keeps its tiles in chunks, with the config's mines per tile as the density
+    this->endlessMode = generationMode == GENERATION_ENDLESS;
+    if (endlessMode) {
+        endless = ChunkedBoard(seed, (double)mineCount / max(1, tiles));
+        placeFlagging = 0; // Counts the flags placed (there is no total to count down from)
+        core = BoardCore(); // The flat tile storage is not used
+    } else {
+        endless = ChunkedBoard(); // Drops the chunks of an endless game played before a restart
+    }
+}
+
+// Picks the atlas cell for a tile based on its current state and game conditions
+TileFace Board::faceOf(uint8_t tile) const {
+    bool tile_mine = tile & TILE_MINE;
+    bool tile_flagged = tile & TILE_FLAGGED;
+    bool tile_revealed = tile & TILE_REVEALED;
+    bool tile_enabled = tile & TILE_ENABLED;
+    int nearbyMines = tile & TILE_COUNT_MASK;
+
+    if (is_debugMode && tile_mine) {
+        // In debug mode, display mines even if hidden (flagged mines keep their flag)
+        return tile_flagged ? FACE_HIDDEN_FLAG_MINE : FACE_HIDDEN_MINE;
+    } else if (is_debugMode && !tile_mine) {
+        // In debug mode, display hidden or revealed non-mines
+        if (!tile_revealed && !tile_flagged) return FACE_HIDDEN;       // Hidden and not flagged
+        else if (!tile_revealed && tile_flagged) return FACE_HIDDEN_FLAG; // Hidden but flagged
+        else if (tile_revealed && nearbyMines == 0) return FACE_REVEALED; // Revealed with no adjacent mines
+        else return TileFace(FACE_NUMBER_1 + nearbyMines - 1);        // Revealed with adjacent mines
+    } else if (loser && tile_mine) {
+        // Show all mines when the player loses
+        return tile_flagged ? FACE_REVEALED_FLAG_MINE : FACE_REVEALED_MINE;
+    } else if (winner && tile_mine) {
+        // Show all mines as flagged when the player wins
+        return FACE_HIDDEN_FLAG;
+    }
+
+    // Handle other game states (general cases for hidden, revealed, flagged tiles)
+    TileFace face = FACE_BLANK; // Disabled hidden tiles are not drawn
+    if (!tile_revealed && !tile_flagged && tile_enabled) {
+        face = FACE_HIDDEN; // Hidden and active tile
+    } else if (!tile_revealed && tile_flagged) {
+        face = FACE_HIDDEN_FLAG; // Hidden but flagged
+    } else if (tile_revealed) {
+        // Revealed tiles, with their number if they have surrounding mines
+        face = (nearbyMines > 0 && !tile_mine) ? TileFace(FACE_NUMBER_1 + nearbyMines - 1) : FACE_REVEALED;
+    }
+
+    if (is_paused) face = FACE_REVEALED; // Show revealed state when the game is paused
+    if (leaderBoard && !winner) face = FACE_REVEALED; // Show leaderboard view for non-winners
+    return face;
+}
+
+// Maps a window pixel to a tile index by dividing its board coordinates by the tile size
+int Board::tileAt(const RenderWindow &window, Vector2i pixel, const View &view) const {
+    Vector2f position = window.mapPixelToCoords(pixel, view);
+    if (position.x < 0 || position.y < 0) return -1; // Left of or above the board
+
+    int column = (int)(position.x / TILE_SIZE);
+    int row = (int)(position.y / TILE_SIZE);
+    if (column >= columns || row >= rows) return -1; // Right of or below the board
+    return core.index(row, column);
+}
+
+// Endless boards read their tiles from the chunks (building the ones that come into view)
+TileFace Board::faceAt(int row, int column) {
+    return endlessMode ? faceOf(endless.tileAt(column, row)) : face(core.index(row, column));
+}
+
+// Rounds down, so the tiles left of and above the origin get negative coordinates
+Vector2i Board::tileCoordinatesAt(const RenderWindow &window, Vector2i pixel, const View &view) const {
+    Vector2f position = window.mapPixelToCoords(pixel, view);
+    return Vector2i((int)floor(position.x / TILE_SIZE), (int)floor(position.y / TILE_SIZE));
+}
+
+// Draws the visible tiles through the renderer
+void Board::draw(RenderTarget &target, const IntRect &visibleTiles) {
+    TRACE_SCOPE("Board::draw");
+    renderer.draw(target, *this, visibleTiles);
+}
+
+const float CAMERA_MIN_ZOOM = 0.25f; // Closest zoom: tiles at 4x their size.
+const float CAMERA_MAX_ZOOM = 8.0f;  // Farthest zoom: tiles of 4 pixels.
+const float ENDLESS_CAMERA_EXTENT = 1 << 24; // Farthest an endless camera moves from the origin in world pixels (floats hold whole pixels up to 2^24).
+
+// BoardCamera constructor: the view covers the board area at 1:1, starting at the top-left tile
+BoardCamera::BoardCamera(float areaWidth, float areaHeight, float windowWidth, float windowHeight, int columns, int rows, bool endless)
+    : endless(endless) {
+    areaSize = Vector2f(areaWidth, areaHeight);
+    boardSize = Vector2f((float)columns * TILE_SIZE, (float)rows * TILE_SIZE);
+    view.setViewport(FloatRect(0, 0, areaWidth / windowWidth, areaHeight / windowHeight));
+    reset();
+}
+
+// Keeps the zoom in range and the view over the board (centered on an axis the board doesn't fill)
+void BoardCamera::apply() {
+    if (endless) {
+        zoom = max(CAMERA_MIN_ZOOM, min(zoom, CAMERA_MAX_ZOOM));
+        center.x = max(-ENDLESS_CAMERA_EXTENT, min(center.x, ENDLESS_CAMERA_EXTENT));
+        center.y = max(-ENDLESS_CAMERA_EXTENT, min(center.y, ENDLESS_CAMERA_EXTENT));
+        view.setSize(Vector2f(areaSize.x * zoom, areaSize.y * zoom));
+        view.setCenter(center);
+        return;
     }
 
-    // Randomly assign mines to tiles
-    for (int i = 0; i < this->mineCount; i++) {
-        int randomRow = Random(0, rows - 1);
-        int randomColumn = Random(0, columns - 1);
+    float fitZoom = max(boardSize.x / areaSize.x, boardSize.y / areaSize.y); // Zoom that shows the whole board
+    zoom = max(CAMERA_MIN_ZOOM, min(zoom, max(1.0f, min(CAMERA_MAX_ZOOM, fitZoom))));
+
+    Vector2f extent(areaSize.x * zoom, areaSize.y * zoom);
+    center.x = extent.x >= boardSize.x ? boardSize.x / 2 : max(extent.x / 2, min(center.x, boardSize.x - extent.x / 2));
+    center.y = extent.y >= boardSize.y ? boardSize.y / 2 : max(extent.y / 2, min(center.y, boardSize.y - extent.y / 2));
+    view.setSize(extent);
+    view.setCenter(center);
+}
+
+// Dragging right moves the view left, so the board follows the mouse
+void BoardCamera::pan(Vector2f windowPixels) {
+    center.x -= windowPixels.x * zoom;
+    center.y -= windowPixels.y * zoom;
+    apply();
+}
+
+// The world point under the pixel is the same before and after the zoom
+void BoardCamera::zoomAt(Vector2i pixel, float factor) {
+    Vector2f offset(pixel.x - areaSize.x / 2, pixel.y - areaSize.y / 2); // Pixel relative to the area center
+    Vector2f world(center.x + offset.x * zoom, center.y + offset.y * zoom);
+    zoom *= factor;
+    apply();
+    center = Vector2f(world.x - offset.x * zoom, world.y - offset.y * zoom);
+    apply();
+}
+
+// Centers the view on a world point (e.g., a click on the minimap)
+void BoardCamera::centerOn(Vector2f world) {
+    center = world;
+    apply();
+}
+
+// Back to 1:1 with the top-left corner of the board at the top-left of the area
+void BoardCamera::reset() {
+    zoom = 1;
+    center = Vector2f(areaSize.x / 2, areaSize.y / 2);
+    apply();
+}
+
+// The board area is the top of the window, above the HUD
+bool BoardCamera::contains(Vector2i pixel) const {
+    return pixel.x >= 0 && pixel.y >= 0 && pixel.x < areaSize.x && pixel.y < areaSize.y;
+}
+
+// Converts the world area in view to a clipped range of tiles
+IntRect BoardCamera::visibleTiles() const {
+    FloatRect world = worldRect();
+    if (endless) {
+        int left = (int)floor(world.left / TILE_SIZE);
+        int top = (int)floor(world.top / TILE_SIZE);
+        int right = (int)ceil((world.left + world.width) / TILE_SIZE);
+        int bottom = (int)ceil((world.top + world.height) / TILE_SIZE);
+        return IntRect(left, top, right - left, bottom - top);
+    }
+    int columns = (int)(boardSize.x / TILE_SIZE);
+    int rows = (int)(boardSize.y / TILE_SIZE);
+    int left = max(0, (int)floor(world.left / TILE_SIZE));
+    int top = max(0, (int)floor(world.top / TILE_SIZE));
+    int right = min(columns, (int)ceil((world.left + world.width) / TILE_SIZE));
+    int bottom = min(rows, (int)ceil((world.top + world.height) / TILE_SIZE));
+    return IntRect(left, top, max(0, right - left), max(0, bottom - top));
+}
+
+// The view's size around its center
+FloatRect BoardCamera::worldRect() const {
+    return FloatRect(center.x - areaSize.x * zoom / 2, center.y - areaSize.y * zoom / 2, areaSize.x * zoom, areaSize.y * zoom);
+}
+
+// The whole board is in view when the view is at least as large as the board on both axes
+bool BoardCamera::showsWholeBoard() const {
+    if (endless) return false;
+    return areaSize.x * zoom >= boardSize.x && areaSize.y * zoom >= boardSize.y;
+}
+
+// The board at 1:1, unless that is larger than the desktop (less room for the title bar and taskbar)
+Vector2u gameWindowSize(int columns, int rows, int hudHeight) {
+    VideoMode desktop = VideoMode::getDesktopMode();
+    unsigned maxWidth = desktop.width * 9 / 10;
+    unsigned maxHeight = desktop.height * 8 / 10;
+    unsigned width = min((unsigned)columns * TILE_SIZE, maxWidth);
+    unsigned height = min((unsigned)rows * TILE_SIZE, maxHeight - hudHeight);
+    return Vector2u(width, height + hudHeight);
+}
+
+// Marks a list of tiles for update on the next frame
+void BoardRenderer::tilesChanged(const vector<int> &tiles) {
+    changedTiles.insert(changedTiles.end(), tiles.begin(), tiles.end());
+}
+
+// Marks a single tile for update on the next frame
+void BoardRenderer::tileChanged(int index) {
+    changedTiles.push_back(index);
+}
+
+// Marks every tile for update on the next frame
+void BoardRenderer::allTilesChanged() {
+    allChanged = true;
+}
+
+// Writes the quad of a visible tile: its place on the board and the atlas cell of its face
+void BoardRenderer::writeQuad(Board &board, int row, int column) {
+    TileFace face = board.faceAt(row, column);
+    float left = (face % TILE_ATLAS_COLUMNS) * TILE_SIZE;
+    float top = (face / TILE_ATLAS_COLUMNS) * TILE_SIZE;
+    float x = (float)column * TILE_SIZE;
+    float y = (float)row * TILE_SIZE;
+
+    Vertex *quad = &quads[((row - visible.top) * visible.width + (column - visible.left)) * 4];
+    quad[0] = Vertex(Vector2f(x, y), Vector2f(left, top));
+    quad[1] = Vertex(Vector2f(x + TILE_SIZE, y), Vector2f(left + TILE_SIZE, top));
+    quad[2] = Vertex(Vector2f(x + TILE_SIZE, y + TILE_SIZE), Vector2f(left + TILE_SIZE, top + TILE_SIZE));
+    quad[3] = Vertex(Vector2f(x, y + TILE_SIZE), Vector2f(left, top + TILE_SIZE));
+}
 
-        // Ensure the randomly chosen tile is not already a mine
-        if (boardPointer2D.at(randomRow)->at(randomColumn)->tile_mine) {
-            i--; // Retry if the tile is already a mine
-        } else {
-            boardPointer2D.at(randomRow)->at(randomColumn)->tile_mine = true;
+// Rewrites the visible quads when the view or the conditions changed, else only the changed tiles in view
+void BoardRenderer::draw(RenderTarget &target, Board &board, const IntRect &visibleTiles) {
+    // A change in the game conditions can change the face of any tile
+    uint8_t conditions = board.is_debugMode | board.is_paused << 1 | board.leaderBoard << 2 | board.loser << 3 | board.winner << 4;
+    if (conditions != lastConditions) {
+        lastConditions = conditions;
+        allChanged = true;
+    }
+
+    bool moved = visibleTiles.left != visible.left || visibleTiles.top != visible.top || visibleTiles.width != visible.width || visibleTiles.height != visible.height;
+    if (moved || allChanged) {
+        TRACE_SCOPE("BoardRenderer::writeQuads"); // Every visible tile's quad (what a per-tile draw used to cost)
+        visible = visibleTiles;
+        quads.setPrimitiveType(Quads);
+        quads.resize((size_t)visible.width * visible.height * 4);
+        for (int i = visible.top; i < visible.top + visible.height; i++) {
+            for (int j = visible.left; j < visible.left + visible.width; j++) writeQuad(board, i, j);
         }
+    } else {
+        for (int index : changedTiles) {
+            int row = index / board.columns;
+            int column = index % board.columns;
+            if (visible.contains(column, row)) writeQuad(board, row, column); // Off-screen tiles are written when they come into view
+        }
+    }
+    changedTiles.clear();
+    allChanged = false;
+
+    drawCounted(target, quads, &TextureCache::instance().tileAtlas());
+}
+
+// Queues the block of every changed tile once
+void Minimap::tilesChanged(const vector<int> &tiles) {
+    for (int index : tiles) tileChanged(index);
+}
+
+// Queues the block of a changed tile (nothing to track before the first draw lays out the blocks)
+void Minimap::tileChanged(int index) {
+    if (allDirty) return;
+    int block = (index / boardColumns / blockSize) * blockColumns + (index % boardColumns) / blockSize;
+    if (!blockDirty[block]) {
+        blockDirty[block] = 1;
+        dirtyBlocks.push_back(block);
     }
+}
 
-    // Assign neighboring tiles and calculate surrounding mine counts
-    for (int i = 0; i < boardPointer2D.size(); i++) {
-        for (int j = 0; j < boardPointer2D.at(i)->size(); j++) {
-            Tile *currentTile = boardPointer2D.at(i)->at(j);
-
-            // Add neighboring tiles
-            if (j - 1 >= 0) currentTile->vectorOfNeighborTilePointers.push_back(boardPointer2D.at(i)->at(j - 1)); // Left
-            if ((i - 1 >= 0) && (j - 1 >= 0)) currentTile->vectorOfNeighborTilePointers.push_back(boardPointer2D.at(i - 1)->at(j - 1)); // Top-left
-            if (i - 1 >= 0) currentTile->vectorOfNeighborTilePointers.push_back(boardPointer2D.at(i - 1)->at(j)); // Top
-            if ((i - 1 >= 0) && (j + 1 < columns)) currentTile->vectorOfNeighborTilePointers.push_back(boardPointer2D.at(i - 1)->at(j + 1)); // Top-right
-            if (j + 1 < columns) currentTile->vectorOfNeighborTilePointers.push_back(boardPointer2D.at(i)->at(j + 1)); // Right
-            if ((i + 1 < rows) && (j + 1 < columns)) currentTile->vectorOfNeighborTilePointers.push_back(boardPointer2D.at(i + 1)->at(j + 1)); // Bottom-right
-            if (i + 1 < rows) currentTile->vectorOfNeighborTilePointers.push_back(boardPointer2D.at(i + 1)->at(j)); // Bottom
-            if ((i + 1 < rows) && (j - 1 >= 0)) currentTile->vectorOfNeighborTilePointers.push_back(boardPointer2D.at(i + 1)->at(j - 1)); // Bottom-left
-
-            // Count surrounding mines (skip if the current tile is a mine)
-            if (!currentTile->tile_mine) {
-                for (Tile *neighbor : currentTile->vectorOfNeighborTilePointers) {
-                    if (neighbor->tile_mine) currentTile->nearbyMines++;
-                }
-            }
+// Colors a block by how much of it is revealed, or red if a flag is in it
+void Minimap::shadeBlock(const Board &board, int block) {
+    int firstRow = (block / blockColumns) * blockSize;
+    int firstColumn = (block % blockColumns) * blockSize;
+    int lastRow = min(board.rows, firstRow + blockSize);
+    int lastColumn = min(board.columns, firstColumn + blockSize);
+
+    int revealed = 0, flagged = 0;
+    for (int i = firstRow; i < lastRow; i++) {
+        const uint8_t *tile = &board.core.state[(size_t)i * board.columns];
+        for (int j = firstColumn; j < lastColumn; j++) {
+            revealed += (tile[j] & TILE_REVEALED) != 0;
+            flagged += (tile[j] & TILE_FLAGGED) != 0;
         }
     }
+
+    Uint8 *pixel = &pixels[(size_t)block * 4];
+    if (flagged > 0) {
+        pixel[0] = 200; pixel[1] = 50; pixel[2] = 50;
+    } else {
+        Uint8 shade = (Uint8)(110 + 115 * revealed / ((lastRow - firstRow) * (lastColumn - firstColumn)));
+        pixel[0] = pixel[1] = pixel[2] = shade;
+    }
+    pixel[3] = 230;
 }
 
-// Renders the board and its tiles on the game window
-void Board::draw(RenderWindow &window) {
-    for (unsigned i = 0; i < boardPointer2D.size(); i++) {
-        for (unsigned j = 0; j < boardPointer2D.at(i)->size(); j++) {
-            boardPointer2D.at(i)->at(j)->draw(window, this->is_debugMode, this->is_paused, this->leaderBoard, this->loser, this->winner);
+// Recomputes the queued blocks, uploads the rectangle around them, then draws the picture and the camera outline
+void Minimap::draw(RenderTarget &target, const Board &board, Vector2f topRight, const FloatRect &cameraRect) {
+    TRACE_SCOPE("Minimap::draw");
+    if (allDirty || boardColumns != board.columns) {
+        // Lay out the blocks so the longer side of the board fits in MINIMAP_SIZE pixels, then shade them all
+        blockSize = max(1, (max(board.columns, board.rows) + MINIMAP_SIZE - 1) / MINIMAP_SIZE);
+        blockColumns = (board.columns + blockSize - 1) / blockSize;
+        blockRows = (board.rows + blockSize - 1) / blockSize;
+        boardColumns = board.columns;
+        pixels.assign((size_t)blockColumns * blockRows * 4, 0);
+        blockDirty.assign((size_t)blockColumns * blockRows, 0);
+        dirtyBlocks.clear();
+        for (int block = 0; block < blockColumns * blockRows; block++) shadeBlock(board, block);
+        texture.create(blockColumns, blockRows);
+        texture.update(pixels.data(), blockColumns, blockRows, 0, 0);
+        allDirty = false;
+    } else if (!dirtyBlocks.empty()) {
+        // Shade the changed blocks and upload the smallest rectangle that holds them
+        int left = blockColumns, top = blockRows, right = 0, bottom = 0;
+        for (int block : dirtyBlocks) {
+            shadeBlock(board, block);
+            blockDirty[block] = 0;
+            left = min(left, block % blockColumns);
+            right = max(right, block % blockColumns + 1);
+            top = min(top, block / blockColumns);
+            bottom = max(bottom, block / blockColumns + 1);
+        }
+        dirtyBlocks.clear();
+
+        int width = right - left, height = bottom - top;
+        upload.resize((size_t)width * height * 4);
+        for (int i = 0; i < height; i++) {
+            const Uint8 *source = &pixels[((size_t)(top + i) * blockColumns + left) * 4];
+            copy(source, source + width * 4, &upload[(size_t)i * width * 4]);
         }
+        texture.update(upload.data(), width, height, left, top);
     }
+
+    // Scale the picture so its longer side is MINIMAP_SIZE pixels
+    scale = (float)MINIMAP_SIZE / max(blockColumns, blockRows);
+    position = Vector2f(topRight.x - blockColumns * scale, topRight.y);
+    Sprite picture(texture);
+    picture.setPosition(position);
+    picture.setScale(scale, scale);
+    drawCounted(target, picture);
+
+    // Outline the part of the board the camera shows
+    float worldToMap = scale / (blockSize * TILE_SIZE);
+    float left = max(0.0f, cameraRect.left * worldToMap), top = max(0.0f, cameraRect.top * worldToMap);
+    float right = min(blockColumns * scale, (cameraRect.left + cameraRect.width) * worldToMap);
+    float bottom = min(blockRows * scale, (cameraRect.top + cameraRect.height) * worldToMap);
+    RectangleShape outline(Vector2f(max(1.0f, right - left), max(1.0f, bottom - top)));
+    outline.setPosition(position.x + left, position.y + top);
+    outline.setFillColor(Color::Transparent);
+    outline.setOutlineColor(Color::Yellow);
+    outline.setOutlineThickness(1);
+    drawCounted(target, outline);
+}
+
+// Hit test against the rectangle the minimap was last drawn in
+bool Minimap::contains(Vector2f pixel) const {
+    return !allDirty && FloatRect(position.x, position.y, blockColumns * scale, blockRows * scale).contains(pixel);
+}
+
+// Maps a minimap pixel back to the world point it shows
+Vector2f Minimap::worldAt(Vector2f pixel) const {
+    float mapToWorld = blockSize * TILE_SIZE / scale;
+    return Vector2f((pixel.x - position.x) * mapToWorld, (pixel.y - position.y) * mapToWorld);
 }
 
 // Toggles the debug mode state
@@ -265,59 +604,73 @@ void Board::toggleOfLB() {
 
 // Disables all tiles on the board
 void Board::disableTiles() {
-    for (unsigned i = 0; i < boardPointer2D.size(); i++) {
-        for (unsigned j = 0; j < boardPointer2D.at(i)->size(); j++) {
-            boardPointer2D.at(i)->at(j)->tile_enabled = false;
-        }
-    }
+    GameEngine::disableTiles();
+    endless.enabled = false;
+    renderer.allTilesChanged();
 }
 
 // Enables all tiles on the board
 void Board::enableAllTiles() {
-    for (unsigned i = 0; i < boardPointer2D.size(); i++) {
-        for (unsigned j = 0; j < boardPointer2D.at(i)->size(); j++) {
-            boardPointer2D.at(i)->at(j)->tile_enabled = true;
-        }
-    }
+    GameEngine::enableAllTiles();
+    endless.enabled = true;
+    renderer.allTilesChanged();
 }
 
-// Reveals a tile and its neighbors recursively if applicable
-void Board::reveal(RenderWindow &window, Tile *tile) {
-    if (tile->tile_flagged) return; // Do not reveal flagged tiles
+// Reveals a tile through the engine and reports the changed tiles to the renderer, minimap and solver
+vector<int> Board::reveal(int index) {
+    TRACE_SCOPE("Board::reveal");
+    vector<int> revealedTiles;
+    GameEngine::reveal(index, revealedTiles);
+    renderer.tilesChanged(revealedTiles);
+    minimap.tilesChanged(revealedTiles);
+    solver.tilesRevealed(core, revealedTiles);
+    return revealedTiles;
+}
 
-    tile->tile_revealed = true;
+// Saves the engine state through the bit-packed save format
+bool Board::save(const string& path, const string& playerName, Time elapsed) const {
+    return saveGame(path, *this, playerName, elapsed.asMicroseconds());
+}
 
-    if (tile->nearbyMines == 0 && tile->tile_enabled) { // Recursive case for empty tiles
-        for (Tile *neighbor : tile->vectorOfNeighborTilePointers) {
-            if (!neighbor->tile_revealed && neighbor->tile_enabled) {
-                reveal(window, neighbor);
-            }
-        }
-    }
+// Loads the engine state, then starts the renderer, the minimap and the solver over for the new board
+bool Board::resume(const string& path, string& playerName, Time& elapsed) {
+    int64_t elapsedMicroseconds;
+    if (!loadGame(path, *this, playerName, elapsedMicroseconds)) return false;
+    elapsed = microseconds(elapsedMicroseconds);
+    if (!loser && !winner) core.setAllEnabled(true); // A game saved while paused resumes unpaused
+    renderer = BoardRenderer();
+    minimap = Minimap();
+    solver = Solver(); // Starts over from the loaded board on its next solve()
+    return true;
 }
 
-// Checks if the player has won the game
-bool Board::checkIfWinner() {
-    int revealedSafeTiles = 0;
-    for (unsigned i = 0; i < boardPointer2D.size(); i++) {
-        for (unsigned j = 0; j < boardPointer2D.at(i)->size(); j++) {
-            Tile *tile = boardPointer2D.at(i)->at(j);
-            if (!tile->tile_mine && tile->tile_revealed) {
-                revealedSafeTiles++;
-                if (revealedSafeTiles == tiles - mineCount) return true; // Win condition met
-            }
-        }
+// Toggles the flag on a tile through the engine
+bool Board::toggleFlag(int index) {
+    bool changed = GameEngine::toggleFlag(index);
+    if (changed) {
+        renderer.tileChanged(index);
+        minimap.tileChanged(index);
+        solver.flagToggled(core, index);
     }
-    return false;
+    return changed;
 }
 
-// Clears the board by deallocating memory (like a destructor)
-void Board::clear() {
-    for (unsigned i = 0; i < boardPointer2D.size(); i++) {
-        vector<Tile *> *currRow = boardPointer2D.at(i);
-        for (Tile *tile : *currRow) {
-            delete tile;
-        }
-        delete currRow;
+// Reveals a tile of the endless board; the renderer's change list holds flat indices, so the
+// visible quads are rewritten instead (a viewport's worth of tiles)
+long long Board::revealAt(int column, int row) {
+    TRACE_SCOPE("Board::revealAt");
+    long long revealed = endless.reveal(column, row);
+    loser = endless.loser;
+    renderer.allTilesChanged();
+    return revealed;
+}
+
+// Toggles a flag on the endless board and shows the number of flags placed
+bool Board::toggleFlagAt(int column, int row) {
+    bool changed = endless.toggleFlag(column, row);
+    if (changed) {
+        placeFlagging = (int)min(999LL, endless.flagsPlaced); // The counter has three digits
+        renderer.allTilesChanged();
     }
+    return changed;
 }
@@ -1,6 +1,15 @@
 #pragma once
 #include <iostream>
+#include <map>
+#include <cstdint>
+#include <ctime>
+#include <string>
 #include <SFML/Graphics.hpp>
+#include "gameEngine.h"
+#include "solver.h"
+#include "saveGame.h"
+#include "chunkedBoard.h"
+#include "trace.h"
 using namespace std;
 using namespace sf;
 
@@ -47,71 +56,351 @@ public:
         return paused ? theGameTime : theGameTime + theGameClock.getElapsedTime();
     }
 
+    // Sets the elapsed time (e.g. when resuming a saved game), keeping the paused state.
+    void setElapsedTime(Time elapsed) {
+        theGameTime = elapsed;
+        theGameClock.restart();
+    }
+
     // Returns whether the stopwatch is currently paused.
     bool isPaused() {
         return paused;
     }
 };
 
-// The Tile class represents a single tile in a Minesweeper game.
-// Each tile has textures, state flags (e.g., is it revealed or flagged?), 
-// and a list of pointers to neighboring tiles.
-class Tile {
+// The RenderScheduler class decides when a window needs a new frame. A frame is drawn only
+// when something changed (an event, a game state change or a new second on the timer) and
+// never faster than the frame cap; the rest of the time the loop blocks waiting for events
+// instead of spinning. It also counts frames and CPU time for the exit report.
+class RenderScheduler {
+    // Private member variables:
+    Clock frameClock;          // Time since the last frame was drawn.
+    Clock lifetimeClock;       // Time since the scheduler was created.
+    clock_t startCpuTime;      // Process CPU time when the scheduler was created.
+    Time minimumFrameTime;     // Shortest time between two frames (1 / frame cap).
+    bool dirty = true;         // Indicates whether the window content is out of date.
+    int shownTimerSecond = -1; // Timer second shown by the last frame.
+    long long framesDrawn = 0; // Number of frames drawn.
+
+public:
+    // Constructor: creates a scheduler with the given frame cap (frames per second, 0 for no cap).
+    explicit RenderScheduler(unsigned frameCap = 60);
+
+    // Changes the frame cap (frames per second, 0 for no cap).
+    void setFrameCap(unsigned frameCap);
+
+    // Marks the window content as out of date.
+    void invalidate() { dirty = true; }
+
+    // Marks the window content as out of date if the timer shows a different second.
+    void timerShows(int second);
+
+    // Returns whether a frame should be drawn now (something changed and the frame cap allows it).
+    bool shouldDraw();
+
+    // Records that a frame was drawn.
+    void frameDrawn();
+
+    // Returns how long the loop may block: until the frame cap allows a pending frame, until the
+    // timer's next second when 'timerRunning', or Time::Zero to block until the next event.
+    Time waitTime(bool timerRunning, Time timerElapsed);
+
+    // Waits for an event for at most 'timeout' (blocks until one arrives if it is Time::Zero).
+    // Returns whether 'event' was filled; further events are then read with pollEvent.
+    bool waitForEvent(Window &window, Event &event, Time timeout);
+
+    // Prints the frame count, frames per second and CPU usage since the scheduler was created.
+    void printReport(const string &windowName);
+};
+
+// The TextWidget class is a retained piece of UI text. The Text object is built once, and it
+// is only re-laid-out (centered on its anchor point) when its string actually changes, instead
+// of constructing a new Text every frame.
+class TextWidget {
+    // Private member variables:
+    Text text;               // The SFML text, kept between frames.
+    String content;          // The string currently shown.
+    Vector2f center;         // Point the text is centered on.
+    bool layoutDirty = true; // Indicates whether the text must be centered again before drawing.
+
+public:
+    // Constructor: creates the text with its font, size, color, style and center point.
+    TextWidget(const Font &font, unsigned size, Color color, Uint32 style, Vector2f centerPoint, const String &value = "");
+
+    // Changes the string; the layout is only invalidated if it differs from the current one.
+    void setString(const String &value);
+
+    // Draws the text, centering it first if its string changed since the last draw.
+    void draw(RenderTarget &target);
+};
+
+// The FrameOverlay class is the on-screen readout of a tracing build (MS_TRACE, F3 shows or
+// hides it): how long the last frame took to build and draw on the CPU, its draw calls and the
+// events handled since the frame before. Draw calls are counted by drawCounted().
+class FrameOverlay {
+    // Private member variables:
+    Text text;                  // The readout, in the top-left corner of the window.
+    RectangleShape background;  // Dark box behind the readout.
+    Clock frameClock;           // Restarted when a frame begins.
+    int events = 0;             // Events handled since the last frame.
+    static int drawCalls;       // Draw calls since the frame began.
+
+public:
+    bool visible = true; // Indicates whether the readout is drawn.
+
+    // Constructor: a readout in the given font.
+    explicit FrameOverlay(const Font &font);
+
+    // Counts one draw call (called by drawCounted in tracing builds).
+    static void countDrawCall() { drawCalls++; }
+
+    // Counts one handled event.
+    void countEvent() { events++; }
+
+    // Starts timing a frame and its draw calls.
+    void frameStarted();
+
+    // Updates the readout with the frame so far, then draws it (its own two draws are not counted).
+    void draw(RenderTarget &target);
+};
+
+// Draws through the target and, in tracing builds, counts the call for the frame overlay.
+inline void drawCounted(RenderTarget &target, const Drawable &drawable, const RenderStates &states = RenderStates::Default) {
+    if (TRACE_ENABLED) FrameOverlay::countDrawCall();
+    target.draw(drawable, states);
+}
+
+// The TileFace enum names the cells of the tile atlas.
+// Each cell is a fully composed tile image (e.g., a hidden tile with a flag on it),
+// so every tile is drawn as exactly one textured quad.
+enum TileFace {
+    FACE_BLANK,              // Nothing is drawn (disabled hidden tiles).
+    FACE_HIDDEN,             // Hidden tile.
+    FACE_REVEALED,           // Revealed tile with no nearby mines.
+    FACE_HIDDEN_FLAG,        // Hidden tile with a flag.
+    FACE_HIDDEN_MINE,        // Hidden tile with a mine (debug mode).
+    FACE_HIDDEN_FLAG_MINE,   // Hidden tile with a flag and a mine (debug mode).
+    FACE_REVEALED_MINE,      // Revealed tile with a mine (game lost).
+    FACE_REVEALED_FLAG_MINE, // Revealed tile with a flag and a mine (game lost).
+    FACE_NUMBER_1,           // Revealed tiles showing 1 to 8 nearby mines (FACE_NUMBER_1 + count - 1).
+    FACE_COUNT = FACE_NUMBER_1 + 8
+};
+
+const int TILE_SIZE = 32;          // Width and height of a tile in pixels.
+const int TILE_ATLAS_COLUMNS = 4;  // Number of cells per row in the tile atlas.
+
+// The TextureCache class loads each image file once and hands out shared references.
+// Buttons and the digits sprite sheet read their textures from here, and the tile
+// images are composed once into a single atlas texture used by the BoardRenderer.
+class TextureCache {
+    // Private member variables:
+    map<string, Texture> textures; // Loaded textures keyed by file path (map keeps references stable).
+    Texture atlas;                 // Composed tile atlas (FACE_COUNT cells of TILE_SIZE pixels).
+    bool atlasLoaded = false;      // Indicates whether the atlas has been built.
+
+    TextureCache() {} // Only reachable through instance().
+
+public:
+    // Returns the process-wide cache.
+    static TextureCache& instance();
+
+    // Returns the texture for the given file, loading it from disk the first time it is requested.
+    const Texture& get(const string& path);
+
+    // Returns the tile atlas, building it from the tile images on first use.
+    const Texture& tileAtlas();
+};
+
+struct Board;
+
+// The BoardCamera class is the view of the board area, the part of the window above the HUD.
+// It pans and zooms over the board (the HUD is drawn with the window's default view and stays
+// put), keeps the view over the board, and reports which tiles are visible so only those are
+// drawn. Zooming is limited to between 4x magnification and 8x reduction (tiles of 4 pixels),
+// or the zoom that fits the whole board if that is smaller, so a frame never covers more
+// than a few hundred thousand tiles however large the board is. Over an endless board the
+// camera can zoom out fully and move anywhere within ENDLESS_CAMERA_EXTENT of the origin.
+class BoardCamera {
+    // Private member variables:
+    View view;          // World area shown in the board area.
+    Vector2f areaSize;  // Size of the board area in window pixels.
+    Vector2f boardSize; // Size of the board in world pixels.
+    Vector2f center;    // World point at the center of the board area.
+    float zoom = 1;     // World pixels per window pixel (above 1 zooms out).
+    bool endless;       // Indicates that the board has no edges to keep the view over.
+
+    // Clamps the zoom and the center, then updates the view.
+    void apply();
+
+public:
+    // Constructor: a camera for a board area of 'areaWidth' by 'areaHeight' pixels at the top of a
+    // window of 'windowWidth' by 'windowHeight' pixels, showing the top-left of the board at 1:1.
+    // An 'endless' camera ignores the board size.
+    BoardCamera(float areaWidth, float areaHeight, float windowWidth, float windowHeight, int columns, int rows, bool endless = false);
+
+    // Returns the view to draw the board with.
+    const View& getView() const { return view; }
+
+    // Moves the view by a distance in window pixels (e.g., a mouse drag).
+    void pan(Vector2f windowPixels);
+
+    // Zooms by 'factor' (above 1 zooms out) keeping the world point under 'pixel' in place.
+    void zoomAt(Vector2i pixel, float factor);
+
+    // Centers the view on a world point.
+    void centerOn(Vector2f world);
+
+    // Returns to 1:1 with the top-left of the board in view.
+    void reset();
+
+    // Returns whether a window pixel is in the board area.
+    bool contains(Vector2i pixel) const;
+
+    // Returns the visible tiles (left column, top row, columns and rows), clipped to the board
+    // (on an endless board they may be negative).
+    IntRect visibleTiles() const;
+
+    // Returns the world area in view.
+    FloatRect worldRect() const;
+
+    // Returns whether the whole board is in view.
+    bool showsWholeBoard() const;
+};
+
+// Returns the size of a window for a board of the given size: the board at 1:1 plus a HUD of
+// 'hudHeight' pixels, shrunk to fit the desktop when the board is larger than the screen.
+Vector2u gameWindowSize(int columns, int rows, int hudHeight);
+
+// The BoardRenderer class draws the visible part of the board with a single draw call.
+// It keeps one quad per visible tile in a vertex array, so a frame costs as much as the
+// viewport, not the board. The quads are rebuilt when the visible tiles or the game
+// conditions change; otherwise only the tiles reported as changed are rewritten.
+class BoardRenderer {
     // Private member variables:
-    Texture tileHidden;    // Texture for a hidden (default) tile.
-    Texture revealedTileTexture;  // Texture for a revealed tile.
-    Texture mineTexture;          // Texture for a tile containing a mine.
-    Texture textureWithFlag;          // Texture for a flagged tile.
-    Texture textureOne;     // Texture for a tile showing the number 1.
-    Texture textureTwo;     // Texture for a tile showing the number 2.
-    Texture textureThree;   // Texture for a tile showing the number 3.
-    Texture textureFour;    // Texture for a tile showing the number 4.
-    Texture textureFive;    // Texture for a tile showing the number 5.
-    Texture textureSix;     // Texture for a tile showing the number 6.
-    Texture textureSeven;   // Texture for a tile showing the number 7.
-    Texture textureEight;   // Texture for a tile showing the number 8.
+    VertexArray quads;          // Four vertices per visible tile, row by row over 'visible'.
+    IntRect visible;            // Tiles covered by the quads (left column, top row, columns, rows).
+    vector<int> changedTiles;   // Tiles whose state changed since the last frame.
+    bool allChanged = true;     // Indicates that every visible tile must be rewritten on the next frame.
+    uint8_t lastConditions = 0; // Game conditions (debug, paused, ...) the quads were written for.
+
+    // Writes the position and texture coordinates of the quad of a visible tile.
+    void writeQuad(Board& board, int row, int column);
 
 public:
-    Sprite sprite;  // Sprite representing the tile.
-    vector<Tile*> vectorOfNeighborTilePointers; // Pointers to up to 8 neighboring tiles.
+    // Marks a list of tiles (e.g., the result of a reveal) for update on the next frame.
+    void tilesChanged(const vector<int>& tiles);
 
-    bool tile_mine;     // Indicates if the tile contains a mine.
-    bool tile_flagged;  // Indicates if the tile is flagged.
-    bool tile_enabled;  // Indicates if the tile is interactable.
-    bool tile_revealed; // Indicates if the tile has been revealed.
-    int nearbyMines; // Number of mines in the neighboring tiles.
+    // Marks a single tile for update on the next frame.
+    void tileChanged(int index);
 
-    // Parameterized constructor: Initializes a tile with its coordinates.
-    Tile(int xCoordinate, int yCoordinate);
+    // Marks every tile for update on the next frame.
+    void allTilesChanged();
 
-    // Draws the tile on the game window based on its state and game conditions.
-    void draw(RenderWindow& window, bool is_debugMode, bool is_paused, bool leaderBoard, bool loser, bool winner);
+    // Updates the quads of the visible tiles that changed and draws them with the target's current view.
+    // The board isn't const because an endless board builds the chunks that come into view.
+    void draw(RenderTarget& target, Board& board, const IntRect& visibleTiles);
 
-    // Toggles the flagged state of the tile.
-    void toggleFlag();
+    // Returns the number of tiles drawn by the last frame.
+    size_t quadCount() const { return quads.getVertexCount() / 4; }
 };
 
-// The Board struct represents the Minesweeper game board.
-// It contains all tiles and manages their interactions and game states.
-struct Board {
+const int MINIMAP_SIZE = 160; // Length of the longer side of the minimap in pixels.
+
+// The Minimap class is a low-resolution picture of the whole board. Each pixel summarizes a
+// square block of tiles (gray when hidden, lighter as more of it is revealed, red if it holds
+// a flag). The picture is kept in a texture, and only the blocks that contain changed tiles are
+// recomputed and uploaded, so a reveal costs as much as the blocks it touches.
+class Minimap {
+    // Private member variables:
+    Texture texture;           // One texel per block.
+    vector<Uint8> pixels;      // RGBA colors of every block, row by row.
+    vector<Uint8> upload;      // Scratch buffer for the changed rectangle of blocks.
+    vector<uint8_t> blockDirty; // Indicates whether a block is in 'dirtyBlocks'.
+    vector<int> dirtyBlocks;   // Blocks whose tiles changed since the last frame.
+    bool allDirty = true;      // Indicates that every block must be recomputed (new board).
+    int blockSize = 1;         // Width and height of a block in tiles.
+    int blockColumns = 0;      // Number of blocks per row.
+    int blockRows = 0;         // Number of blocks per column.
+    int boardColumns = 0;      // Number of columns of the board the blocks were laid out for.
+    Vector2f position;         // Top-left corner of the minimap in window pixels (set when drawn).
+    float scale = 1;           // Window pixels per block (set when drawn).
+
+    // Recomputes the color of one block from its tiles.
+    void shadeBlock(const Board& board, int block);
+
+public:
+    // Marks the blocks of a list of tiles for update on the next frame.
+    void tilesChanged(const vector<int>& tiles);
+
+    // Marks the block of a single tile for update on the next frame.
+    void tileChanged(int index);
+
+    // Updates the changed blocks and draws the minimap with its top-right corner at 'topRight'
+    // (window pixels), with an outline around the world area in 'cameraRect'.
+    void draw(RenderTarget& target, const Board& board, Vector2f topRight, const FloatRect& cameraRect);
+
+    // Returns whether a window pixel is on the minimap drawn last.
+    bool contains(Vector2f pixel) const;
+
+    // Returns the world point shown at a window pixel of the minimap drawn last.
+    Vector2f worldAt(Vector2f pixel) const;
+};
+
+// The Board struct is the on-screen Minesweeper board.
+// The game rules live in the GameEngine it extends; the board adds the debug, pause and
+// leaderboard display modes, the renderer, the hint solver and mouse hit testing.
+// With the endless generation mode the tiles live in a ChunkedBoard instead of the engine's flat
+// core (which is left empty): tiles are addressed by column and row through revealAt,
+// toggleFlagAt and faceAt, the config's size only sets the window and its mines per tile set the
+// density, the flag counter counts up, and there is no win, solver, save or replay log.
+struct Board : public GameEngine {
     // Variables:
-    int rows;   // Number of rows in the board.
-    int columns; // Number of columns in the board.
-    int tiles;   // Total number of tiles.
-    int placeFlagging; // Number of flags available for placement.
-    int mineCount;    // Total number of mines on the board.
-    vector<vector<Tile*>*> boardPointer2D; // 2D vector holding all tile pointers.
     bool is_debugMode; // Indicates if debug mode is active (e.g., reveals all mines).
     bool is_paused;    // Indicates if the game is paused.
     bool leaderBoard;  // Indicates if leaderboard mode is active.
-    bool loser;        // Indicates if the game is lost.
-    bool winner;       // Indicates if the game is won.
+    bool endlessMode;  // Indicates if the board is an endless, chunked board.
+    ChunkedBoard endless;   // Tiles of an endless board (unused otherwise).
+    BoardRenderer renderer; // Batched renderer holding the vertex array of the visible tiles.
+    Minimap minimap;        // Low-resolution picture of the whole board.
+    Solver solver;          // Finds provably safe tiles and mines for hints and auto-play.
 
     // Methods:
-    Board(); // Default constructor: Initializes the board with default settings.
+    Board(); // Default constructor: Initializes the board with the settings in files/config.cfg.
+
+    // Parameterized constructor: Initializes a board with the given size and mine count.
+    Board(const BoardConfig& config);
+
+    // Parameterized constructor: Initializes a board whose mines are placed from 'seed', so the
+    // same seed and clicks always give the same game.
+    Board(const BoardConfig& config, uint32_t seed);
+
+    // A board owns its tiles, renderer and textures; restarts reuse it instead of copying a new one over it.
+    Board(const Board&) = delete;
+    Board& operator=(const Board&) = delete;
 
-    // Draws or updates the board on the game window.
-    void draw(RenderWindow& window);
+    // Starts a new game on this board as if it had been built with 'config' and 'seed', reusing the
+    // tile storage or taking a ready board from 'queue' (see GameEngine::restart), and starts the
+    // display modes, renderer, minimap and solver over.
+    void restart(const BoardConfig& config, uint32_t seed, BoardQueue* queue = nullptr);
+
+    // Returns the atlas cell that shows a tile with the packed state 'tile' (TILE_* bits) in the current game conditions.
+    TileFace faceOf(uint8_t tile) const;
+
+    // Returns the atlas cell that shows the tile at 'index' based on its state and the game conditions.
+    TileFace face(int index) const { return faceOf(core.state[index]); }
+
+    // Returns the atlas cell of the tile at a row and column, on either kind of board.
+    TileFace faceAt(int row, int column);
+
+    // Returns the index of the tile under a window pixel, or -1 if the pixel is off the board.
+    // The pixel is mapped through 'view' first, so panning and zooming are taken into account.
+    int tileAt(const RenderWindow& window, Vector2i pixel, const View& view) const;
+
+    // Returns the column (x) and row (y) of the tile under a window pixel, with no bounds (for endless boards).
+    Vector2i tileCoordinatesAt(const RenderWindow& window, Vector2i pixel, const View& view) const;
+
+    // Draws the visible tiles with the target's current view (the camera's view).
+    void draw(RenderTarget& target, const IntRect& visibleTiles);
 
     // Toggles debug mode on or off.
     void toggleDebugMode();
@@ -128,12 +417,28 @@ struct Board {
     // Enables all tiles, allowing interactions.
     void enableAllTiles();
 
-    // Reveals a tile and triggers any associated actions.
-    void reveal(RenderWindow& window, Tile* tile);
+    // Reveals the tile at 'index' through the engine and returns the newly revealed tiles.
+    // The renderer and the solver are told which tiles changed.
+    vector<int> reveal(int index);
+
+    // Toggles the flag on the tile at 'index' through the engine.
+    bool toggleFlag(int index);
+
+    // Reveals a tile of an endless board and returns the number of tiles revealed.
+    long long revealAt(int column, int row);
+
+    // Toggles the flag on a tile of an endless board and returns whether anything changed.
+    bool toggleFlagAt(int column, int row);
+
+    // Saves the game with the player's name and the elapsed time (see saveGame.h for the format).
+    bool save(const string& path, const string& playerName, Time elapsed) const;
 
-    // Checks if the player has won the game.
-    bool checkIfWinner();
+    // Replaces the game with one saved by save(). Returns false, leaving the board as it was,
+    // if 'path' doesn't hold a valid save.
+    bool resume(const string& path, string& playerName, Time& elapsed);
 
-    // Clears the board (e.g., resets all tiles).
-    void clear();
+private:
+    // Turns the display modes off and sets up the chunked board for the endless generation mode
+    // (shared by the constructor and restart).
+    void startDisplay();
 };
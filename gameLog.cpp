@@ -0,0 +1,347 @@
+#include "gameLog.h"
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+// Bits of the status field of a state check
+const uint32_t CHECK_MINES_PLACED = 1;
+const uint32_t CHECK_LOSER = 2;
+const uint32_t CHECK_WINNER = 4;
+
+// Hashes every state byte (FNV-1a) and copies the counters the replayer compares
+GameCheck checkOf(const GameEngine& engine) {
+    GameCheck check;
+    check.status = (engine.core.minesPlaced ? CHECK_MINES_PLACED : 0) | (engine.loser ? CHECK_LOSER : 0) | (engine.winner ? CHECK_WINNER : 0);
+    check.revealedSafeTiles = engine.core.revealedSafeTiles;
+    check.flagsPlaced = engine.core.flagsPlaced;
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (uint8_t tile : engine.core.state) {
+        hash = (hash ^ tile) * 0x100000001b3ull;
+    }
+    check.stateHash = hash;
+    return check;
+}
+
+// Appends an unsigned value as a LEB128 varint (7 bits per byte, high bit set on all but the last)
+static void putVarint(vector<uint8_t>& bytes, uint64_t value) {
+    while (value >= 0x80) {
+        bytes.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back((uint8_t)value);
+}
+
+// Reads a varint at 'offset' and advances the offset. Returns false if it runs past the end.
+static bool getVarint(const vector<uint8_t>& bytes, size_t& offset, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (offset >= bytes.size()) return false;
+        uint8_t byte = bytes[offset++];
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false; // More than 10 bytes: not a varint we wrote
+}
+
+// GameLog constructor: the log clock starts now
+GameLog::GameLog() {
+    started = chrono::steady_clock::now();
+}
+
+// Log time: this session's steady clock, continuing from the time the log was read back at
+int64_t GameLog::now() const {
+    return timeOffset + chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - started).count();
+}
+
+// Writes the type and the time since the previous event (the steady clock never goes back)
+int64_t GameLog::begin(uint8_t type) {
+    int64_t time = max(now(), lastTime);
+    bytes.push_back(type);
+    putVarint(bytes, (uint64_t)(time - lastTime));
+    lastTime = time;
+    return time;
+}
+
+// Records the seed and settings, which is all the replayer needs to rebuild the board
+int64_t GameLog::newGame(const BoardConfig& config, uint32_t seed) {
+    recording = true;
+    int64_t time = begin(EVENT_NEW_GAME);
+    putVarint(bytes, seed);
+    putVarint(bytes, (uint64_t)config.columns);
+    putVarint(bytes, (uint64_t)config.rows);
+    putVarint(bytes, (uint64_t)config.mineCount);
+    putVarint(bytes, (uint64_t)config.generationMode);
+    return time;
+}
+
+// Records an action; only reveals and flags carry a tile index (and layouts their value)
+int64_t GameLog::record(GameEventType type, int64_t tile) {
+    if (!recording) return now();
+    int64_t time = begin(type);
+    if (type == EVENT_REVEAL || type == EVENT_FLAG || type == EVENT_LAYOUT) putVarint(bytes, (uint64_t)tile);
+    return time;
+}
+
+// Records the game time the resumed game continues from
+int64_t GameLog::resume(int64_t gameMicroseconds) {
+    if (!recording) return now();
+    int64_t time = begin(EVENT_RESUME);
+    putVarint(bytes, (uint64_t)gameMicroseconds);
+    return time;
+}
+
+// Records the game time and the state check the replayer must arrive at
+int64_t GameLog::end(const GameEngine& engine, int64_t gameMicroseconds) {
+    if (!recording) return now();
+    GameCheck check = checkOf(engine);
+    int64_t time = begin(EVENT_END);
+    putVarint(bytes, (uint64_t)gameMicroseconds);
+    putVarint(bytes, check.status);
+    putVarint(bytes, (uint64_t)check.revealedSafeTiles);
+    putVarint(bytes, (uint64_t)check.flagsPlaced);
+    putVarint(bytes, check.stateHash);
+    recording = false;
+    return time;
+}
+
+// Writes the header and the events in one call
+bool GameLog::write(const string& path) const {
+    vector<uint8_t> buffer = {'M', 'S', 'L', 'G'};
+    const uint8_t* version = reinterpret_cast<const uint8_t*>(&LOG_FORMAT_VERSION);
+    buffer.insert(buffer.end(), version, version + sizeof(LOG_FORMAT_VERSION));
+    buffer.insert(buffer.end(), bytes.begin(), bytes.end());
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) return false;
+    bool written = fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+    return fclose(file) == 0 && written;
+}
+
+// Reads the whole file, checks the header and that every event decodes, then continues after the last event
+bool GameLog::read(const string& path) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+    fseek(file, 0, SEEK_END);
+    long fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    vector<uint8_t> buffer(fileSize > 0 ? (size_t)fileSize : 0);
+    bool read = fileSize > 0 && fread(buffer.data(), 1, buffer.size(), file) == buffer.size();
+    fclose(file);
+
+    const size_t headerSize = 4 + sizeof(LOG_FORMAT_VERSION);
+    uint32_t version = 0;
+    if (!read || buffer.size() < headerSize || memcmp(buffer.data(), "MSLG", 4) != 0) return false;
+    memcpy(&version, buffer.data() + 4, sizeof(version));
+    if (version < 1 || version > LOG_FORMAT_VERSION) return false; // A version 1 log is a valid version 2 log
+
+    GameLog loaded;
+    loaded.bytes.assign(buffer.begin() + headerSize, buffer.end());
+    vector<GameEvent> events;
+    if (!loaded.decode(events)) return false;
+
+    bytes.swap(loaded.bytes);
+    lastTime = events.empty() ? 0 : events.back().time;
+    timeOffset = lastTime; // The time between the two sessions isn't part of the log
+    started = chrono::steady_clock::now();
+    recording = !events.empty() && events.front().type == EVENT_NEW_GAME;
+    return true;
+}
+
+// Decodes the events one by one, rejecting unknown types and truncated payloads
+bool GameLog::decode(vector<GameEvent>& events) const {
+    events.clear();
+    size_t offset = 0;
+    int64_t time = 0;
+    while (offset < bytes.size()) {
+        GameEvent event;
+        event.type = bytes[offset++];
+        if (event.type >= EVENT_TYPE_COUNT) return false;
+
+        uint64_t delta;
+        if (!getVarint(bytes, offset, delta)) return false;
+        time += (int64_t)delta;
+        event.time = time;
+
+        uint64_t value = 0;
+        bool valid = true;
+        switch (event.type) {
+            case EVENT_NEW_GAME: {
+                uint64_t columns = 0, rows = 0, mines = 0, mode = 0;
+                valid = getVarint(bytes, offset, value) && getVarint(bytes, offset, columns) && getVarint(bytes, offset, rows)
+                     && getVarint(bytes, offset, mines) && getVarint(bytes, offset, mode);
+                event.config = BoardConfig{(int)columns, (int)rows, (int)mines, (int)mode};
+                break;
+            }
+            case EVENT_REVEAL:
+            case EVENT_FLAG:
+            case EVENT_RESUME:
+            case EVENT_LAYOUT:
+                valid = getVarint(bytes, offset, value);
+                break;
+            case EVENT_END: {
+                uint64_t status = 0, revealed = 0, flags = 0;
+                valid = getVarint(bytes, offset, value) && getVarint(bytes, offset, status) && getVarint(bytes, offset, revealed)
+                     && getVarint(bytes, offset, flags) && getVarint(bytes, offset, event.check.stateHash);
+                event.check.status = (uint32_t)status;
+                event.check.revealedSafeTiles = (int32_t)revealed;
+                event.check.flagsPlaced = (int32_t)flags;
+                break;
+            }
+            default:
+                break;
+        }
+        if (!valid) return false;
+        event.value = (int64_t)value;
+        events.push_back(event);
+    }
+    return true;
+}
+
+// Stops the game clock, keeping the time it ran
+void GameReplayer::stopClock(int64_t time) {
+    if (clockRunning) {
+        clockElapsed += time - clockSince;
+        clockRunning = false;
+    }
+}
+
+// Starts the game clock if it is stopped
+void GameReplayer::startClock(int64_t time) {
+    if (!clockRunning) {
+        clockSince = time;
+        clockRunning = true;
+    }
+}
+
+// Game time: the accumulated time plus the current run
+int64_t GameReplayer::gameTime(int64_t time) const {
+    return clockRunning ? clockElapsed + time - clockSince : clockElapsed;
+}
+
+// Applies an event with the same rules the game window uses (see main.cpp)
+bool GameReplayer::apply(const GameEvent& event, string& error) {
+    events++;
+    if (!started && event.type != EVENT_NEW_GAME) {
+        error = "event before the first game";
+        return false;
+    }
+
+    switch (event.type) {
+        case EVENT_NEW_GAME:
+            // Restart: a new board, every mode off and the clock restarted from zero
+            if (event.config.columns <= 0 || event.config.rows <= 0 || event.config.mineCount < 0) {
+                error = "invalid board settings";
+                return false;
+            }
+            game = GameEngine(event.config, (uint32_t)event.value);
+            game.noGuessBudgetMilliseconds = 0; // Logged searches come with EVENT_LAYOUT; a version 1 log's had no time limit
+            started = true;
+            paused = debugMode = leaderboard = gameOverHandled = false;
+            pauseEnabled = debugEnabled = true;
+            clockElapsed = 0;
+            clockRunning = false;
+            startClock(event.time);
+            games++;
+            return true;
+
+        case EVENT_REVEAL:
+        case EVENT_FLAG:
+            if (event.value < 0 || event.value >= game.tiles) {
+                error = "tile " + to_string(event.value) + " is off the board";
+                return false;
+            }
+            if (event.type == EVENT_FLAG) {
+                game.toggleFlag((int)event.value);
+                return true;
+            }
+            revealedTiles.clear();
+            game.reveal((int)event.value, revealedTiles);
+
+            // A loss or a win stops the clock and the buttons; a win also opens the leaderboard
+            if ((game.loser || game.winner) && !gameOverHandled) {
+                gameOverHandled = true;
+                stopClock(event.time);
+                game.disableTiles();
+                pauseEnabled = debugEnabled = false;
+                if (game.winner) leaderboard = true;
+            }
+            return true;
+
+        case EVENT_LAYOUT:
+            // The next reveal places the logged candidate instead of searching again
+            if (game.core.minesPlaced || event.value > INT_MAX) {
+                error = game.core.minesPlaced ? "layout logged after the mines were placed" : "invalid layout " + to_string(event.value);
+                return false;
+            }
+            game.layoutCandidate = (int)event.value - 1;
+            return true;
+
+        case EVENT_PAUSE:
+            if (!pauseEnabled) return true; // The button does nothing once the game is over
+            paused = !paused;
+            if (paused) {
+                stopClock(event.time);
+                game.disableTiles();
+                debugEnabled = false;
+            } else {
+                game.enableAllTiles();
+                debugEnabled = true;
+                startClock(event.time);
+            }
+            return true;
+
+        case EVENT_DEBUG:
+            if (!debugEnabled) return true;
+            debugMode = !debugMode;
+            if (debugMode) game.disableTiles();
+            else game.enableAllTiles();
+            return true;
+
+        case EVENT_LEADERBOARD_OPEN:
+            stopClock(event.time);
+            game.disableTiles();
+            leaderboard = true;
+            return true;
+
+        case EVENT_LEADERBOARD_CLOSE:
+            leaderboard = false;
+            if (!paused && !game.loser && !game.winner) {
+                game.enableAllTiles();
+                startClock(event.time);
+            }
+            return true;
+
+        case EVENT_RESUME:
+            // A new session starts from the saved game: unpaused, with the saved game time
+            paused = debugMode = leaderboard = false;
+            pauseEnabled = debugEnabled = true;
+            if (!game.loser && !game.winner) game.enableAllTiles();
+            clockElapsed = event.value;
+            clockSince = event.time;
+            clockRunning = true;
+            return true;
+
+        case EVENT_END: {
+            checks++;
+            GameCheck check = checkOf(game);
+            if (check.status != event.check.status || check.revealedSafeTiles != event.check.revealedSafeTiles
+                || check.flagsPlaced != event.check.flagsPlaced || check.stateHash != event.check.stateHash) {
+                error = "final state of game " + to_string(games) + " differs (replayed " + to_string(check.revealedSafeTiles) + " tiles revealed and "
+                      + to_string(check.flagsPlaced) + " flags, logged " + to_string(event.check.revealedSafeTiles) + " and "
+                      + to_string(event.check.flagsPlaced) + (check.stateHash != event.check.stateHash ? ", tile states differ)" : ")");
+                return false;
+            }
+            int64_t replayedTime = gameTime(event.time);
+            if (llabs(replayedTime - event.value) > REPLAY_TIME_TOLERANCE_MICROSECONDS) {
+                error = "game time of game " + to_string(games) + " is " + to_string(replayedTime) + " us, "
+                      + to_string(event.value) + " us logged";
+                return false;
+            }
+            return true;
+        }
+    }
+    error = "unknown event";
+    return false;
+}
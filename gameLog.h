@@ -0,0 +1,145 @@
+#pragma once
+#include <cstdint>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "gameEngine.h"
+using namespace std;
+
+// Kinds of events stored in a game log.
+enum GameEventType : uint8_t {
+    EVENT_NEW_GAME,          // A game starts (the first game and every restart): seed and board settings.
+    EVENT_REVEAL,            // A tile is revealed (a click or an auto-play move): tile index.
+    EVENT_FLAG,              // A flag is toggled: tile index.
+    EVENT_PAUSE,             // The pause button is pressed.
+    EVENT_DEBUG,             // The debug button is pressed.
+    EVENT_LEADERBOARD_OPEN,  // The leaderboard button is pressed.
+    EVENT_LEADERBOARD_CLOSE, // The leaderboard window is closed.
+    EVENT_RESUME,            // A saved game is resumed in a new session: game time in microseconds.
+    EVENT_END,               // The game is left (restart or window closed): game time and final state check.
+    EVENT_LAYOUT,            // The no-guess search before a first reveal ends: candidate number + 1 (0 for a random layout).
+    EVENT_TYPE_COUNT
+};
+
+// Summary of a game's state, recorded when the game is left and compared by the replayer.
+struct GameCheck {
+    uint32_t status = 0;         // Bits: mines placed (1), lost (2), won (4).
+    int32_t revealedSafeTiles = 0;
+    int32_t flagsPlaced = 0;
+    uint64_t stateHash = 0;      // FNV-1a hash of every tile's state byte.
+};
+
+// Returns the state check of a game.
+GameCheck checkOf(const GameEngine& engine);
+
+// One decoded log event.
+struct GameEvent {
+    uint8_t type = EVENT_NEW_GAME;
+    int64_t time = 0;   // Microseconds since the log was started.
+    int64_t value = 0;  // Tile index (reveal, flag), seed (new game), layout (see EVENT_LAYOUT) or game time in microseconds (resume, end).
+    BoardConfig config = BoardConfig{0, 0, 0}; // Board settings (new game).
+    GameCheck check;    // Final state (end).
+};
+
+// Log file layout: "MSLG", format version (uint32), then the events back to back. Each event is
+// its type byte followed by unsigned LEB128 varints: the microseconds since the previous event,
+// then the payload (tile index; seed, columns, rows, mines and generation mode for a new game;
+// the layout for a no-guess search; game time for a resume; game time, status, revealed tiles,
+// flags and state hash for an end). A reveal or flag usually takes 3 to 5 bytes. Version 2 added
+// EVENT_LAYOUT; version 1 logs are still read (their no-guess searches had no time limit).
+const uint32_t LOG_FORMAT_VERSION = 2;
+
+// The GameLog class records every action of a session as a compact, timestamped event log.
+// Events are only recorded once a game has started in the log (newGame, or a log read back
+// from disk), so a game that can't be replayed from its seed never produces a partial log.
+class GameLog {
+    // Private member variables:
+    vector<uint8_t> bytes;                     // Encoded events (without the file header).
+    chrono::steady_clock::time_point started;  // Time origin of this session's events.
+    int64_t timeOffset = 0;                    // Log time at which this session started.
+    int64_t lastTime = 0;                      // Time of the last recorded event.
+    bool recording = false;                    // Indicates whether a game is being recorded.
+
+    // Appends an event header (type and time delta) and returns its time.
+    int64_t begin(uint8_t type);
+
+public:
+    // Constructor: starts an empty log whose clock starts now.
+    GameLog();
+
+    // Returns the current log time in microseconds.
+    int64_t now() const;
+
+    // Records the start of a game with its settings and seed, and starts recording. Returns the event time.
+    int64_t newGame(const BoardConfig& config, uint32_t seed);
+
+    // Records an action (reveal, flag, pause, debug, leaderboard) with its tile index, or a
+    // layout with its value. Returns the event time.
+    int64_t record(GameEventType type, int64_t tile = 0);
+
+    // Records that a saved game was resumed with the given game time. Returns the event time.
+    int64_t resume(int64_t gameMicroseconds);
+
+    // Records the end of the current game with its game time and final state, and stops recording
+    // until the next newGame (a game that isn't logged, like an endless one, may follow). Returns the event time.
+    int64_t end(const GameEngine& engine, int64_t gameMicroseconds);
+
+    // Returns whether a game is being recorded.
+    bool isRecording() const { return recording; }
+
+    // Returns the size of the encoded events in bytes.
+    size_t size() const { return bytes.size(); }
+
+    // Writes the log to 'path' and returns whether it succeeded.
+    bool write(const string& path) const;
+
+    // Replaces the log with the one stored at 'path' and keeps recording after its last event
+    // (used when the saved game it ends with is resumed). Returns false, leaving the log as it was,
+    // if the file is missing or not a valid log.
+    bool read(const string& path);
+
+    // Decodes every event. Returns false if the encoded events are truncated or malformed.
+    bool decode(vector<GameEvent>& events) const;
+};
+
+// The GameReplayer class re-executes logged events against a GameEngine with no window, no
+// frame pacing and no real time: it applies the same rules as the game window for the clock
+// and for the pause, debug and leaderboard modes, and checks every game's end against the log.
+class GameReplayer {
+    // Private member variables:
+    GameEngine game = GameEngine(BoardConfig{1, 1, 0}, 0); // The game being replayed.
+    vector<int> revealedTiles; // Scratch list for reveals.
+    bool started = false;      // Indicates whether a game has started.
+    bool paused = false;       // Indicates whether the game is paused.
+    bool debugMode = false;    // Indicates whether debug mode is on.
+    bool leaderboard = false;  // Indicates whether the leaderboard window is open.
+    bool pauseEnabled = true;  // Indicates whether the pause button works (not after the game ends).
+    bool debugEnabled = true;  // Indicates whether the debug button works (not while paused or after the game ends).
+    bool gameOverHandled = false; // Indicates whether the loss or win has stopped the clock.
+    bool clockRunning = false; // Indicates whether the game clock is running.
+    int64_t clockElapsed = 0;  // Game time accumulated up to 'clockSince'.
+    int64_t clockSince = 0;    // Log time at which the clock last started.
+
+    // Stops or starts the game clock at log time 'time'.
+    void stopClock(int64_t time);
+    void startClock(int64_t time);
+
+public:
+    long long games = 0;   // Games started.
+    long long events = 0;  // Events applied.
+    long long checks = 0;  // Game ends verified.
+
+    // Applies one event. Returns false and describes the problem in 'error' if the event can't be
+    // applied or the end of a game doesn't match the log.
+    bool apply(const GameEvent& event, string& error);
+
+    // Returns the game time at log time 'time' in microseconds.
+    int64_t gameTime(int64_t time) const;
+
+    // Returns the game being replayed.
+    const GameEngine& engine() const { return game; }
+};
+
+// Largest difference between the logged and the replayed game time that is accepted. The window
+// reads its stopwatch a few microseconds after it stamps the events that start or stop it.
+const int64_t REPLAY_TIME_TOLERANCE_MICROSECONDS = 10000;
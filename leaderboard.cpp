@@ -0,0 +1,133 @@
+#include "leaderboard.h"
+#include "trace.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+// Formats a time as MM:SS (minutes keep growing past 99)
+static string formatTime(int32_t seconds) {
+    int32_t minutes = seconds / 60;
+    int32_t remainder = seconds % 60;
+    return (minutes < 10 ? "0" : "") + to_string(minutes) + ":" + (remainder < 10 ? "0" : "") + to_string(remainder);
+}
+
+// Builds the difficulty key from the board size and mine count; random layouts keep the untagged
+// key the files already use, and no-guess wins (easier) get their own
+string difficultyKey(const BoardConfig& config) {
+    string key = to_string(config.columns) + "x" + to_string(config.rows) + "x" + to_string(config.mineCount);
+    return config.generationMode == GENERATION_NO_GUESS ? key + "-ng" : key;
+}
+
+// New entries always go into the tree; the flat vector only changes on compaction
+void Leaderboard::insert(const LeaderboardEntry& entry) {
+    recent.insert(entry);
+}
+
+// Merges the heads of the flat vector and the tree
+vector<LeaderboardEntry> Leaderboard::top(int count) const {
+    vector<LeaderboardEntry> best;
+    LeaderboardOrder before;
+    auto flat = compacted.begin();
+    auto tree = recent.begin();
+    while ((int)best.size() < count && (flat != compacted.end() || tree != recent.end())) {
+        if (tree == recent.end() || (flat != compacted.end() && before(*flat, *tree))) best.push_back(*flat++);
+        else best.push_back(*tree++);
+    }
+    return best;
+}
+
+// Counts the entries ordered before 'entry' in both parts, stopping once it can't be in the top
+int Leaderboard::positionInTop(const LeaderboardEntry& entry, int count) const {
+    LeaderboardOrder before;
+    int position = (int)(lower_bound(compacted.begin(), compacted.end(), entry, before) - compacted.begin());
+    for (auto tree = recent.begin(); tree != recent.end() && position < count && before(*tree, entry); tree++) position++;
+    return position < count ? position : -1;
+}
+
+// Parses every line once; lines already in order extend the flat vectors, the rest go to the trees
+LeaderboardStore::LeaderboardStore(const string& filePath, const string& defaultDifficulty) : path(filePath) {
+    TRACE_SCOPE("LeaderboardStore::load");
+    ifstream file(path);
+    string line;
+    LeaderboardOrder before;
+    while (getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back(); // Files written on Windows
+        size_t colon = line.find(':');
+        size_t comma = line.find(',', colon);
+        if (colon == string::npos || comma == string::npos) continue; // Not a score line
+
+        LeaderboardEntry entry;
+        entry.seconds = (int32_t)(strtol(line.c_str(), nullptr, 10) * 60 + strtol(line.c_str() + colon + 1, nullptr, 10));
+        entry.sequence = nextSequence++;
+        size_t secondComma = line.find(',', comma + 1);
+        entry.name = line.substr(comma + 1, secondComma == string::npos ? string::npos : secondComma - comma - 1);
+        string difficulty = secondComma == string::npos ? defaultDifficulty : line.substr(secondComma + 1);
+
+        Leaderboard& leaderboard = boards[difficulty];
+        if (leaderboard.recent.empty() && (leaderboard.compacted.empty() || !before(entry, leaderboard.compacted.back()))) {
+            leaderboard.compacted.push_back(entry);
+        } else {
+            leaderboard.recent.insert(entry);
+            appendedSinceCompaction++;
+        }
+        totalEntries++;
+    }
+}
+
+// Returns the leaderboard of a difficulty, creating an empty one if needed
+const Leaderboard& LeaderboardStore::board(const string& difficulty) {
+    return boards[difficulty];
+}
+
+// Appends the win as one line and compacts once the unsorted tail grows past an eighth of the file
+int LeaderboardStore::addScore(const string& difficulty, int32_t seconds, const string& name, int topCount) {
+    TRACE_SCOPE("LeaderboardStore::addScore");
+    LeaderboardEntry entry;
+    entry.seconds = seconds;
+    entry.name = name;
+    entry.name.erase(remove_if(entry.name.begin(), entry.name.end(), [](char c) { return c == ',' || c == '\n' || c == '\r'; }), entry.name.end());
+    entry.sequence = nextSequence++;
+
+    Leaderboard& leaderboard = boards[difficulty];
+    leaderboard.insert(entry);
+    int position = leaderboard.positionInTop(entry, topCount);
+
+    ofstream file(path, ios::app);
+    file << formatTime(seconds) << "," << entry.name << "," << difficulty << "\n";
+    file.close();
+    appendedSinceCompaction++;
+    totalEntries++;
+
+    if (appendedSinceCompaction > max((size_t)1024, totalEntries / 8)) compact();
+    return position;
+}
+
+// Writes a sorted copy next to the file, then swaps it in
+void LeaderboardStore::compact() {
+    TRACE_SCOPE("LeaderboardStore::compact");
+    string temporaryPath = path + ".tmp";
+    ofstream file(temporaryPath, ios::trunc);
+    nextSequence = 0;
+    for (auto& board : boards) {
+        const string& difficulty = board.first;
+        Leaderboard& leaderboard = board.second;
+        vector<LeaderboardEntry> merged;
+        merged.reserve(leaderboard.size());
+        std::merge(leaderboard.compacted.begin(), leaderboard.compacted.end(), leaderboard.recent.begin(),
+                   leaderboard.recent.end(), back_inserter(merged), LeaderboardOrder());
+        for (LeaderboardEntry& entry : merged) {
+            entry.sequence = nextSequence++; // File order now matches the index order
+            file << formatTime(entry.seconds) << "," << entry.name << "," << difficulty << "\n";
+        }
+        leaderboard.compacted = move(merged);
+        leaderboard.recent.clear();
+    }
+    file.close();
+
+    if (rename(temporaryPath.c_str(), path.c_str()) != 0) { // Windows won't rename over an existing file
+        remove(path.c_str());
+        rename(temporaryPath.c_str(), path.c_str());
+    }
+    appendedSinceCompaction = 0;
+}
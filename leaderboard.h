@@ -0,0 +1,79 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "gameEngine.h"
+using namespace std;
+
+// The LeaderboardEntry struct holds one recorded win.
+struct LeaderboardEntry {
+    int32_t seconds = 0;    // Winning time in seconds (no 'short' overflow on long games).
+    string name;            // Player's name.
+    int64_t sequence = 0;   // Order in which the entry was recorded (breaks ties: earlier wins first).
+};
+
+// Orders entries by time, then by the order they were recorded.
+struct LeaderboardOrder {
+    bool operator()(const LeaderboardEntry& a, const LeaderboardEntry& b) const {
+        return a.seconds != b.seconds ? a.seconds < b.seconds : a.sequence < b.sequence;
+    }
+};
+
+// Returns the key that separates the leaderboards of different board settings (e.g. "30x16x99",
+// or "30x16x99-ng" for no-guess layouts).
+string difficultyKey(const BoardConfig& config);
+
+// The Leaderboard class indexes the wins of one difficulty. Entries loaded from a compacted
+// file are already sorted and stay in a flat vector; entries added later go into an ordered
+// tree, so inserts and top-K queries are O(log n) without re-sorting the history.
+class Leaderboard {
+    // Private member variables:
+    vector<LeaderboardEntry> compacted;                  // Sorted entries from the last compaction.
+    multiset<LeaderboardEntry, LeaderboardOrder> recent; // Entries added since then.
+
+    friend class LeaderboardStore;
+
+public:
+    // Adds an entry to the index.
+    void insert(const LeaderboardEntry& entry);
+
+    // Returns the 'count' best entries, best first.
+    vector<LeaderboardEntry> top(int count) const;
+
+    // Returns the position (0-based) of 'entry' if it is among the 'count' best entries, or -1.
+    int positionInTop(const LeaderboardEntry& entry, int count) const;
+
+    // Returns the number of entries.
+    size_t size() const { return compacted.size() + recent.size(); }
+};
+
+// The LeaderboardStore class keeps the leaderboards of every difficulty in one append-only file.
+// Each line is "MM:SS,Name,difficulty" (minutes may exceed 99); lines without a difficulty come
+// from the old single-board format and belong to 'defaultDifficulty'. The file is parsed once at
+// load time, each new win appends one line, and once enough lines were appended the file is
+// compacted: rewritten sorted by difficulty and time, so the next load can skip sorting.
+class LeaderboardStore {
+    // Private member variables:
+    string path;                          // File holding every recorded win.
+    map<string, Leaderboard> boards;      // Leaderboards by difficulty key.
+    int64_t nextSequence = 0;             // Sequence number of the next recorded entry.
+    size_t appendedSinceCompaction = 0;   // Entries not in sorted order in the file.
+    size_t totalEntries = 0;              // Entries of every difficulty.
+
+public:
+    // Constructor: loads every leaderboard from 'filePath' (a missing file means no wins yet).
+    LeaderboardStore(const string& filePath, const string& defaultDifficulty);
+
+    // Returns the leaderboard of a difficulty (empty if it has no wins yet).
+    const Leaderboard& board(const string& difficulty);
+
+    // Records a win: indexes it, appends it to the file and compacts when due. Commas and line
+    // breaks are removed from the name, since they separate the fields and lines of the file.
+    // Returns the position of the new entry if it is among the 'topCount' best of its difficulty, or -1.
+    int addScore(const string& difficulty, int32_t seconds, const string& name, int topCount = 5);
+
+    // Rewrites the file with every entry sorted, and merges each index into its flat vector.
+    void compact();
+};
@@ -1,45 +1,121 @@
 #include <iostream>
 #include <fstream>  
 #include <string>
+#include <stdexcept> // For rejecting command-line numbers that don't parse
 #include <cctype>   // For character case validation in the welcome screen
-#include <sstream>  
 #include <SFML/Graphics.hpp>  // For graphical interface rendering
 #include "gameHelp.h"
+#include "leaderboard.h"
+#include "gameLog.h"
 using namespace std;  
 using namespace sf;   // Simplifies usage of SFML library components
 
-// Adjusts the position of text to center it within a virtual text box
-void getTheTextRect(Text &text, float xcoord, float ycoord) {
-    FloatRect rectOfText = text.getLocalBounds();
-    text.setOrigin(rectOfText.left + rectOfText.width / 2.0f, rectOfText.top + rectOfText.height / 2.0f);
-    text.setPosition(Vector2f(xcoord, ycoord));
-}
+// Formats the top scores as the leaderboard text ("1\tMM:SS\tName" per line), marking the new high score with an asterisk
+string formatLeaderboardText(const vector<LeaderboardEntry>& topScores, int positionOfNewWinner) {
+    string combiningHighscoreText = ""; // Initialize empty string for the leaderboard
+    for (unsigned int i = 0; i < topScores.size(); i++) { // Iterate through the top 5 scores
+        int tempUserTimeInSeconds = topScores.at(i).seconds;
+        int tempUserMinInt = tempUserTimeInSeconds / 60;
+        string tempUserMinStr = (tempUserMinInt < 10 ? "0" : "") + to_string(tempUserMinInt); // Format minutes as two digits
+        int tempUserSecInt = tempUserTimeInSeconds % 60;
+        string tempUserSecStr = (tempUserSecInt < 10 ? "0" : "") + to_string(tempUserSecInt); // Format seconds as two digits
+        string tempUserTime = tempUserMinStr + ":" + tempUserSecStr;
+        string tempUser = topScores.at(i).name;
+
+        // Add an asterisk to the new high score if applicable
+        if (positionOfNewWinner >= 0 && (int)i == positionOfNewWinner) {
+            tempUser += "*";
+        }
 
-// Creates and configures a Text object with specified properties
-Text setTheTextObj(const string& textString, Font& font, short size, Color color, float xcoord, float ycoord) {
-    Text text(textString, font, size);
-    text.setFillColor(color);
-    getTheTextRect(text, xcoord, ycoord);
-    return text;
+        // Format the leaderboard display
+        if (i == 0) {
+            combiningHighscoreText += to_string(i + 1) + "\t" + tempUserTime + "\t" + tempUser;
+        } else {
+            combiningHighscoreText += "\n\n" + to_string(i + 1) + "\t" + tempUserTime + "\t" + tempUser;
+        }
+    }
+    return combiningHighscoreText;
 }
 
-// Struct to store leaderboard information for players
-struct Player {
-    short secondsTime;  // Player's game time in seconds
-    string name;      // Player's name
-};
+// Identifies the buttons below the board, in the order of the button hit-region table
+enum ButtonId { BUTTON_FACE, BUTTON_DEBUG, BUTTON_PAUSE, BUTTON_LEADERBOARD, BUTTON_COUNT, BUTTON_NONE = -1 };
 
-int main(){
-    
-    Board gameBrd; // Initialize the game board (may take some time to load, causing a delay before the window appears)
+// Returns the button whose hit region contains the point, or BUTTON_NONE
+int buttonAt(const FloatRect (&buttonRegions)[BUTTON_COUNT], Vector2f point) {
+    for (int i = 0; i < BUTTON_COUNT; i++) {
+        if (buttonRegions[i].contains(point)) return i;
+    }
+    return BUTTON_NONE;
+}
+
+int main(int argc, char* argv[]){
+
+    // Read the optional frame cap ("--fps N"; 0 removes the cap) and seed ("--seed N")
+    const char* usage = "Usage: sfmlMsGame [--fps N] [--seed N] (N is a number; --fps 0 removes the cap)";
+    unsigned frameCap = 60;
+    bool seedGiven = false; // Indicates whether the games are seeded from the command line
+    uint64_t baseSeed = 0;  // Seed of the first game; restarts use the streams derived from it
+    for (int i = 1; i + 1 < argc; i++) {
+        if (string(argv[i]) == "--fps") {
+            int fps = -1;
+            try {
+                fps = stoi(argv[i + 1]);
+            } catch (const logic_error&) {} // Not a number: rejected below
+            if (fps < 0) { // A negative cap would wrap around in the unsigned frame cap
+                cerr << usage << endl;
+                return 1;
+            }
+            frameCap = fps;
+        }
+        if (string(argv[i]) == "--seed") {
+            seedGiven = argv[i + 1][0] != '-'; // stoull would wrap a negative seed around
+            try {
+                if (seedGiven) baseSeed = stoull(argv[i + 1]);
+            } catch (const logic_error&) {
+                seedGiven = false; // Not a number
+            }
+            if (!seedGiven) {
+                cerr << usage << endl;
+                return 1;
+            }
+        }
+    }
 
-    // Define dimensions for the Welcome and Game window
-    int widthOfWindow = gameBrd.columns * 32; // Width of the main window, based on the number of columns
-    int heightOfWindow = gameBrd.rows * 32 + 100; // Height of the main window, including extra space for UI elements
+    // Every game carries a seed: the given one (then its derived streams) or a fresh random one
+    int gamesStarted = 0;
+    auto nextGameSeed = [&]() -> uint32_t {
+        uint32_t seed = !seedGiven ? (uint32_t)random_device{}() : gamesStarted == 0 ? (uint32_t)baseSeed : streamSeed(baseSeed, gamesStarted);
+        gamesStarted++;
+        cout << "Game seed: " << seed << endl; // Players include it in their reports
+        return seed;
+    };
+
+    Clock startupClock; // Measures how long the board takes to build before the window appears
+    Board gameBrd(readBoardConfig(), nextGameSeed()); // Initialize the game board (tile textures are loaded once and shared through the TextureCache)
+
+    // Resume the game that was in progress when the window was last closed, if there is one
+    const string saveFile = "files/savegame.bin";
+    string resumedName; // Player's name stored with the saved game
+    Time resumedTime;   // Game time stored with the saved game
+    bool resumed = !gameBrd.endlessMode && gameBrd.resume(saveFile, resumedName, resumedTime); // Endless games are not saved
+    if (resumed) cout << "Resumed the saved game of " << resumedName << endl;
+    cout << "Board of " << gameBrd.columns << "x" << gameBrd.rows << " loaded in " << startupClock.getElapsedTime().asMilliseconds() << " ms" << endl;
+
+    // Boards for the next games are reset on a background thread, so a restart only swaps one in
+    // (one spare board on huge boards, where each costs a byte per tile; none for an endless board)
+    int spareBoards = gameBrd.endlessMode ? 0 : gameBrd.tiles >= HUGE_BOARD_TILES ? 1 : 2;
+    BoardQueue boardQueue(gameBrd.rows, gameBrd.columns, spareBoards);
+
+    // Define dimensions for the Welcome and Game window (the board at 1:1, shrunk to fit the screen for large boards)
+    Vector2u sizeOfWindow = gameWindowSize(gameBrd.columns, gameBrd.rows, 100);
+    int widthOfWindow = sizeOfWindow.x; // Width of the main window, based on the number of columns
+    int heightOfWindow = sizeOfWindow.y; // Height of the main window, including extra space for UI elements
+    int heightOfBoardArea = heightOfWindow - 100; // Height of the part of the window showing the board
+    const float hudTop = heightOfBoardArea + 16; // Top of the buttons below the board area
 
     // Define dimensions for the Leaderboard window
-    int widthOfLB = gameBrd.columns * 16; // Width of the leaderboard window, scaled down from main window
-    int heightOfLB = gameBrd.rows * 16 + 50; // Height of the leaderboard window, with additional space for text
+    int widthOfLB = widthOfWindow / 2; // Width of the leaderboard window, scaled down from main window
+    int heightOfLB = heightOfBoardArea / 2 + 50; // Height of the leaderboard window, with additional space for text
 
     // Load font information from a file
     Font font;
@@ -50,25 +126,42 @@ int main(){
 
     // Variables to store user input and render their name
     String inputTheUser; // Stores the player's name as entered in the welcome screen
-    Text inputTheName; // Renderable Text object for displaying the player's name
+    TextWidget inputTheName(font, 18, Color::Yellow, Text::Bold, Vector2f(widthOfWindow / 2.0f, (heightOfWindow / 2.0f) - 45)); // Player's name, re-laid-out only when it changes
+
+    if (resumed) { // Pre-fill the name of the saved game's player
+        inputTheUser = resumedName;
+        inputTheName.setString(inputTheUser + "|");
+    }
+
+    // The welcome message and the input prompt never change, so they are built once
+    TextWidget textWel(font, 24, Color::White, Text::Bold | Text::Underlined, Vector2f(widthOfWindow / 2.0f, (heightOfWindow / 2.0f) - 150), "WELCOME TO MINESWEEPER!");
+    TextWidget promptOfText(font, 20, Color::White, Text::Bold, Vector2f(widthOfWindow / 2.0f, (heightOfWindow / 2.0f) - 75), "Enter your name:");
 
     // Create the welcome window
     RenderWindow startingWindow(VideoMode(widthOfWindow, heightOfWindow), "Minesweeper", sf::Style::Close);
+    RenderScheduler welcomeScheduler(frameCap); // Redraws the welcome window only after input
     while (startingWindow.isOpen()) { // Runs the loop until the close button (red "X") is pressed
         Event event;
 
-        // Create and style the welcome message text
-        Text textWel = setTheTextObj("WELCOME TO MINESWEEPER!", font, 24, Color::White, widthOfWindow / 2.0f, (heightOfWindow / 2.0f) - 150);
-        textWel.setStyle(Text::Bold | Text::Underlined);
+        // Update and render the welcome window when its content changed
+        if (welcomeScheduler.shouldDraw()) {
+            startingWindow.clear(Color::Blue); // Set the background color to blue
+            textWel.draw(startingWindow); // Draw the welcome message
+            promptOfText.draw(startingWindow); // Draw the input prompt
+            inputTheName.draw(startingWindow); // Draw the current user input with the cursor
+            startingWindow.display(); // Display the updated content on the screen
+            welcomeScheduler.frameDrawn();
+        }
 
-        // Create and style the input prompt text
-        Text promptOfText = setTheTextObj("Enter your name:", font, 20, Color::White, widthOfWindow / 2.0f, (heightOfWindow / 2.0f) - 75);
-        promptOfText.setStyle(Text::Bold);
+        // Process user input and events in the welcome window, blocking until one arrives
+        bool eventWaiting = welcomeScheduler.waitForEvent(startingWindow, event, welcomeScheduler.waitTime(false, Time::Zero));
+        while (eventWaiting || startingWindow.pollEvent(event)) { // Checks for events such as typing or button presses
+            eventWaiting = false;
+            if (event.type != Event::MouseMoved) welcomeScheduler.invalidate(); // Typing changes the name shown
 
-        // Process user input and events in the welcome window
-        while (startingWindow.pollEvent(event)) { // Continuously checks for events such as typing or button presses
             if (event.type == Event::Closed) {
                 // Close the window and exit the application if the close button is clicked
+                welcomeScheduler.printReport("Welcome window");
                 startingWindow.close();
                 return 0;
             } else if (event.type == Event::TextEntered) {
@@ -86,9 +179,8 @@ int main(){
                         inputTheUser += temp; // Append the character to the input string
                     }
 
-                    // Update the Text object with the current input, adding a cursor ("|") at the end
-                    inputTheName = setTheTextObj(inputTheUser + "|", font, 18, Color::Yellow, widthOfWindow / 2.0f, (heightOfWindow / 2.0f) - 45);
-                    inputTheName.setStyle(Text::Bold);
+                    // Update the name text with the current input, adding a cursor ("|") at the end
+                    inputTheName.setString(inputTheUser + "|");
                 }
             } else if (event.type == Event::KeyPressed && event.key.code == Keyboard::Enter && inputTheUser.getSize() != 0) {
                 // Close the welcome window if the "Enter" key is pressed and input is not empty
@@ -96,311 +188,245 @@ int main(){
             } else if (event.type == Event::KeyPressed && event.key.code == Keyboard::BackSpace && inputTheUser.getSize() > 0) {
                 // Remove the last character from the name if "Backspace" is pressed and input is not empty
                 inputTheUser.erase(inputTheUser.getSize() - 1);
-                inputTheName = setTheTextObj(inputTheUser + "|", font, 18, Color::Yellow, widthOfWindow / 2.0f, (heightOfWindow / 2.0f) - 45);
-                inputTheName.setStyle(Text::Bold); // Update the Text object to reflect the new input
+                inputTheName.setString(inputTheUser + "|"); // Update the name text to reflect the new input
             }
         }
-
-        // Update and render the welcome window every frame
-        startingWindow.clear(Color::Blue); // Set the background color to blue
-        startingWindow.draw(textWel); // Draw the welcome message
-        startingWindow.draw(promptOfText); // Draw the input prompt
-        startingWindow.draw(inputTheName); // Draw the current user input with the cursor
-        startingWindow.display(); // Display the updated content on the screen
     }
+    welcomeScheduler.printReport("Welcome window");
+// All button and digit textures come from the shared cache, so each image is loaded only once
+    TextureCache& textureCache = TextureCache::instance();
+
 // Load and configure the "face" button, which indicates the game state (e.g., happy, win, or lose)
     Sprite spriteFaceSym;
-    spriteFaceSym.setPosition((((gameBrd.columns) / 2) * 32) - 32, 32 * (gameBrd.rows + 0.5)); // Centered position at the bottom of the game grid
-    Texture textureOfFace;
-    textureOfFace.loadFromFile("files/images/face_happy.png"); // Initially set to a happy face
-    spriteFaceSym.setTexture(textureOfFace);
+    spriteFaceSym.setPosition(((widthOfWindow / 64) * 32) - 32, hudTop); // Centered position at the bottom of the game grid
+    spriteFaceSym.setTexture(textureCache.get("files/images/face_happy.png")); // Initially set to a happy face
     // No "enabled" flag is needed as this button is always active
 
 // Load and configure the "debug" button for toggling debug mode
     Sprite spriteDebugSym;
-    spriteDebugSym.setPosition(((gameBrd.columns) * 32) - 304, 32 * (gameBrd.rows + 0.5)); // Positioned to the left of the pause button
-    Texture textureOfDebug;
-    textureOfDebug.loadFromFile("files/images/debug.png");
-    spriteDebugSym.setTexture(textureOfDebug);
+    spriteDebugSym.setPosition(widthOfWindow - 304, hudTop); // Positioned to the left of the pause button
+    spriteDebugSym.setTexture(textureCache.get("files/images/debug.png"));
     bool enabledDB = true; // Will be disabled during game over
 
 // Load and configure the "pause" button for pausing the game
     Sprite spritePause;
-    spritePause.setPosition(((gameBrd.columns) * 32) - 240, 32 * (gameBrd.rows + 0.5)); // Positioned to the right of the debug button
-    Texture textPause;
-    textPause.loadFromFile("files/images/pause.png");
-    spritePause.setTexture(textPause);
+    spritePause.setPosition(widthOfWindow - 240, hudTop); // Positioned to the right of the debug button
+    spritePause.setTexture(textureCache.get("files/images/pause.png"));
     bool enabledPB = true; // Will be disabled during game over
 
 // Load and configure the "leaderboard" button for displaying top scores
     Sprite spriteLB;
-    spriteLB.setPosition(((gameBrd.columns) * 32) - 176, 32 * (gameBrd.rows + 0.5)); // Positioned to the right of the pause button
-    Texture textLB;
-    textLB.loadFromFile("files/images/leaderboard.png");
-    spriteLB.setTexture(textLB);
+    spriteLB.setPosition(widthOfWindow - 176, hudTop); // Positioned to the right of the pause button
+    spriteLB.setTexture(textureCache.get("files/images/leaderboard.png"));
     // No "enabled" flag is needed as this button is always active
 
 // Load and configure digit sprites for displaying numbers and symbols (e.g., negative sign)
     Sprite spriteDigits[11];
-    Texture textDigits;
-    textDigits.loadFromFile("files/images/digits.png"); // Contains digits 0-9 and a negative sign
+    const Texture& textDigits = textureCache.get("files/images/digits.png"); // Contains digits 0-9 and a negative sign
     for (unsigned int i = 0; i < 11; i++) {
         spriteDigits[i].setTexture(textDigits); // Assign the shared texture
         spriteDigits[i].setTextureRect(IntRect(i * 21, 0, 21, 32)); // Define the sub-rect for each digit or symbol
     }
 
+// Hit regions of the buttons (they never move, so their bounds are computed once)
+    const FloatRect buttonRegions[BUTTON_COUNT] = {
+        spriteFaceSym.getGlobalBounds(), spriteDebugSym.getGlobalBounds(), spritePause.getGlobalBounds(), spriteLB.getGlobalBounds()
+    };
+
 // Initialize the game clock
     StopWatch clockOfGame; // Tracks the elapsed game time
+    if (resumed) clockOfGame.setElapsedTime(resumedTime); // Continue from the saved game time
+
+// Record every action of the session for the headless replayer (tools/replayer.cpp)
+    const string logFile = "files/replay.mslog";
+    GameLog gameLog; // Its clock starts with the game clock
+    if (!resumed) {
+        if (!gameBrd.endlessMode) gameLog.newGame(BoardConfig{gameBrd.columns, gameBrd.rows, gameBrd.mineCount, gameBrd.generationMode}, gameBrd.seed);
+    } else {
+        // A resumed game continues the log of the session that saved it (which ends with that game)
+        vector<GameEvent> loggedEvents;
+        if (gameLog.read(logFile) && gameLog.decode(loggedEvents) && !loggedEvents.empty() && loggedEvents.back().type == EVENT_END) {
+            gameLog.resume(resumedTime.asMicroseconds());
+        } else {
+            gameLog = GameLog(); // Without its start the game can't be replayed, so recording waits for the next game
+        }
+    }
 
-// Create vectors for storing leaderboard information
-    vector<Player> ScoreHighVector; // Stores the top five scores for display
-    vector<Player> allHighFileVector; // Stores all scores from the leaderboard file
+// Load every leaderboard once (wins are kept per board size and mine count)
+    Clock leaderboardClock; // Measures how long the leaderboard file takes to load
+    string difficulty = difficultyKey(BoardConfig{gameBrd.columns, gameBrd.rows, gameBrd.mineCount, gameBrd.generationMode});
+    LeaderboardStore leaderboardStore("files/leaderboard.txt", difficultyKey(BoardConfig{gameBrd.columns, gameBrd.rows, gameBrd.mineCount})); // Untagged lines predate no-guess layouts
+    vector<LeaderboardEntry> ScoreHighVector = leaderboardStore.board(difficulty).top(5); // Stores the top five scores for display
+    cout << "Leaderboard of " << leaderboardStore.board(difficulty).size() << " wins loaded in " << leaderboardClock.getElapsedTime().asMilliseconds() << " ms" << endl;
 
     int positionOfNewWinner = -1; // Tracks the position of the new high score, if applicable (-1 indicates no new high score)
 
-// Load all high scores from the leaderboard file
-    string storageOfLine; // Temporary storage for each line in the file
-    fstream fileOfScoreHigh("files/leaderboard.txt", ios_base::in); // Open the leaderboard file for reading
-
-    // Read and parse all lines in the leaderboard file
-    while (getline(fileOfScoreHigh, storageOfLine)) {
-        Player tempPlayer;
-        stringstream ss(storageOfLine); // Use stringstream to parse line data
-
-        string highscoreMinString; // Minutes part of the score
-        getline(ss, highscoreMinString, ':'); // Extract minutes up to the colon
-        int highScoreMin = stoi(highscoreMinString); // Convert to integer
-
-        string highscoreSecString; // Seconds part of the score
-        getline(ss, highscoreSecString, ','); // Extract seconds up to the comma
-        int highScoreSec = stoi(highscoreSecString); // Convert to integer
-
-        highScoreSec += (highScoreMin * 60); // Convert total time to seconds
-        tempPlayer.secondsTime = highScoreSec; // Store the time in seconds
-        getline(ss, tempPlayer.name); // Extract the player's name
-
-        allHighFileVector.push_back(tempPlayer); // Add the player's data to the full leaderboard vector
-    }
-    fileOfScoreHigh.close(); // Close the file (good practice)
-
-// Load the top 5 high scores for display
-    fileOfScoreHigh.open("files/leaderboard.txt", ios_base::in); // Re-open the file for reading
-    for (unsigned int i = 0; i < 5 && getline(fileOfScoreHigh, storageOfLine); i++) {
-        Player tempPlayer;
-        stringstream ss(storageOfLine); // Use stringstream to parse line data
+    // Leaderboard window text, rebuilt only when a new score is recorded
+    TextWidget LBText(font, 20, Color::White, Text::Bold | Text::Underlined, Vector2f(widthOfLB / 2.0f, (heightOfLB / 2.0f) - 120), "LEADERBOARD");
+    TextWidget highscoreText(font, 18, Color::White, Text::Bold, Vector2f(widthOfLB / 2.0f, (heightOfLB / 2.0f) + 20), formatLeaderboardText(ScoreHighVector, positionOfNewWinner));
 
-        string highscoreMinString; // Minutes part of the score
-        getline(ss, highscoreMinString, ':'); // Extract minutes up to the colon
-        int highScoreMin = stoi(highscoreMinString); // Convert to integer
+    bool winRecorded = false; // Indicates whether the current win has already been added to the leaderboard
+    bool lossRecorded = false; // Indicates whether the current loss has already updated the UI
 
-        string highscoreSecString; // Seconds part of the score
-        getline(ss, highscoreSecString, ','); // Extract seconds up to the comma
-        int highScoreSec = stoi(highscoreSecString); // Convert to integer
+// Solver-driven helpers
+    int hintTile = -1; // Tile highlighted by the last hint (H key), or -1 for none
+    bool autoPlay = false; // Indicates whether provably safe moves are played automatically (A key)
+    RectangleShape hintOutline(Vector2f(28, 28)); // Outline drawn around the hinted tile
+    hintOutline.setFillColor(Color::Transparent);
+    hintOutline.setOutlineColor(Color::Yellow);
+    hintOutline.setOutlineThickness(2);
 
-        highScoreSec += (highScoreMin * 60); // Convert total time to seconds
-        tempPlayer.secondsTime = highScoreSec; // Store the time in seconds
-        getline(ss, tempPlayer.name); // Extract the player's name
+// Camera over the board area: large boards are panned and zoomed instead of filling the screen
+    BoardCamera camera(widthOfWindow, heightOfBoardArea, widthOfWindow, heightOfWindow, gameBrd.columns, gameBrd.rows, gameBrd.endlessMode);
+    bool draggingView = false; // Indicates whether the middle mouse button is dragging the view
+    Vector2i lastDragPixel;    // Mouse position at the previous drag step
+    bool showMinimap = true;   // Indicates whether the minimap is shown when the board doesn't fit (M key)
 
-        ScoreHighVector.push_back(tempPlayer); // Add the player's data to the active leaderboard vector
-    }
-    fileOfScoreHigh.close(); // Close the file (good practice)
+// Tracing builds (make TRACEFLAGS=-DMS_TRACE) show a frame overlay and write a Chrome trace when the window closes
+    const string traceFile = "files/trace.json";
+    FrameOverlay frameOverlay(font);
 
 // Create the main game window
     RenderWindow gameWindow(VideoMode(widthOfWindow, heightOfWindow), "Minesweeper", sf::Style::Close);
+    RenderScheduler gameScheduler(frameCap); // Redraws the game window only when something changed
     while (gameWindow.isOpen()) { // Run until the window is closed
-        gameWindow.clear(Color::White); // Clear the window with a white background
-        gameBrd.draw(gameWindow); // Render the game board
-
-        // Calculate the current game time in minutes and seconds
-        int minsInCurrentUser = clockOfGame.getElapsedTime().asSeconds() / 60;
-        int secsInCurrentUser = ((int)clockOfGame.getElapsedTime().asSeconds()) % 60;
-
-        // Display the mine count (if negative, show a negative sign)
-        if (gameBrd.placeFlagging < 0) {
-            spriteDigits[10].setPosition(12, (32 * (gameBrd.rows + 0.5)) + 16); // Display the negative sign
-            gameWindow.draw(spriteDigits[10]);
-        }
-
-        // Display the mine count when positive
-        if (gameBrd.placeFlagging >= 0) {
-            int mineCountHundredsDigit = gameBrd.placeFlagging / 100; // Hundreds digit
-            spriteDigits[mineCountHundredsDigit].setPosition(33, (32 * (gameBrd.rows + 0.5)) + 16);
-            gameWindow.draw(spriteDigits[mineCountHundredsDigit]);
-
-            int mineCountTensDigit = (gameBrd.placeFlagging % 100) / 10; // Tens digit
-            spriteDigits[mineCountTensDigit].setPosition(54, (32 * (gameBrd.rows + 0.5)) + 16);
-            gameWindow.draw(spriteDigits[mineCountTensDigit]);
-
-            int mineCountOnesDigit = gameBrd.placeFlagging % 10; // Ones digit
-            spriteDigits[mineCountOnesDigit].setPosition(75, (32 * (gameBrd.rows + 0.5)) + 16);
-            gameWindow.draw(spriteDigits[mineCountOnesDigit]);
-        } else if (gameBrd.placeFlagging < 0) { // Handle negative mine count
-            gameBrd.placeFlagging = abs(gameBrd.placeFlagging); // Temporarily convert to positive for calculations
-
-            int mineCountHundredsDigit = gameBrd.placeFlagging / 100; // Hundreds digit
-            spriteDigits[mineCountHundredsDigit].setPosition(33, (32 * (gameBrd.rows + 0.5)) + 16);
-            gameWindow.draw(spriteDigits[mineCountHundredsDigit]);
-
-            int mineCountTensDigit = (gameBrd.placeFlagging % 100) / 10; // Tens digit
-            spriteDigits[mineCountTensDigit].setPosition(54, (32 * (gameBrd.rows + 0.5)) + 16);
-            gameWindow.draw(spriteDigits[mineCountTensDigit]);
-
-            int mineCountOnesDigit = gameBrd.placeFlagging % 10; // Ones digit
-            spriteDigits[mineCountOnesDigit].setPosition(75, (32 * (gameBrd.rows + 0.5)) + 16);
-            gameWindow.draw(spriteDigits[mineCountOnesDigit]);
-
-            gameBrd.placeFlagging *= -1; // Revert mine count back to negative
-        }
-
-        // Set the position of the timer digits on the bottom-right corner of the screen
-        spriteDigits[minsInCurrentUser / 10].setPosition((gameBrd.columns * 32) - 97, (32 * (gameBrd.rows + 0.5)) + 16); // Left digit of minutes
-        gameWindow.draw(spriteDigits[minsInCurrentUser / 10]); // Draw the left minute digit immediately
-
-        spriteDigits[minsInCurrentUser % 10].setPosition((gameBrd.columns * 32) - 76, (32 * (gameBrd.rows + 0.5)) + 16); // Right digit of minutes
-        gameWindow.draw(spriteDigits[minsInCurrentUser % 10]); // Draw the right minute digit immediately
-
-        spriteDigits[secsInCurrentUser / 10].setPosition((gameBrd.columns * 32) - 54, (32 * (gameBrd.rows + 0.5)) + 16); // Left digit of seconds
-        gameWindow.draw(spriteDigits[secsInCurrentUser / 10]); // Draw the left second digit immediately
-
-        spriteDigits[secsInCurrentUser % 10].setPosition((gameBrd.columns * 32) - 33, (32 * (gameBrd.rows + 0.5)) + 16); // Right digit of seconds
-        gameWindow.draw(spriteDigits[secsInCurrentUser % 10]); // Draw the right second digit immediately
-
         Event eventOfGame;
 
-        // Capture the location of the mouse click within the game window
-        auto clickPositionWindow = Mouse::getPosition(gameWindow); // Pixel coordinates of the click
-        auto clickWindow = gameWindow.mapPixelToCoords(Mouse::getPosition(gameWindow)); // Map click to game world coordinates
-
-        // Render the UI components that need updating every frame
-        gameWindow.draw(spriteFaceSym); // Draw the "face" button
-        gameWindow.draw(spriteDebugSym); // Draw the "debug" button
-        gameWindow.draw(spritePause); // Draw the "pause" button
-        gameWindow.draw(spriteLB); // Draw the "leaderboard" button
-        gameWindow.display(); // Display the updated content on the screen
-
-        // Continuously check for events within the game window
-        while (gameWindow.pollEvent(eventOfGame)) {
+        // Block until an event arrives, the timer shows a new second or a held-back frame is due
+        bool eventWaiting = gameScheduler.waitForEvent(gameWindow, eventOfGame, gameScheduler.waitTime(!clockOfGame.isPaused(), clockOfGame.getElapsedTime()));
 
-            // If the leaderboard is active, create and manage the leaderboard window
-            if (gameBrd.leaderBoard) {
-                RenderWindow windowLB(VideoMode(widthOfLB, heightOfLB), "Minesweeper", sf::Style::Close);
-                while (windowLB.isOpen()) {
+        // Handle the waiting event and every other queued event within the game window
+        while (eventWaiting || gameWindow.pollEvent(eventOfGame)) {
+            TRACE_SCOPE("handle event");
+            eventWaiting = false;
+            frameOverlay.countEvent();
+            if (eventOfGame.type != Event::MouseMoved) gameScheduler.invalidate(); // Anything but mouse movement may change the screen
 
-                    windowLB.clear(Color::Blue); // Set the leaderboard window background to blue
-                    Text LBText = setTheTextObj("LEADERBOARD", font, 20, Color::White, widthOfLB / 2.0f, (heightOfLB / 2.0f) - 120);
-                    LBText.setStyle(Text::Bold | Text::Underlined);
-
-                    // Combine high scores into a formatted string for display
-                    string combiningHighscoreText = ""; // Initialize empty string for the leaderboard
-                    for (unsigned int i = 0; i < ScoreHighVector.size(); i++) { // Iterate through the top 5 scores
-                        short tempUserTimeInSeconds = ScoreHighVector.at(i).secondsTime;
-                        int tempUserMinInt = tempUserTimeInSeconds / 60;
-                        string tempUserMinStr = (tempUserMinInt < 10 ? "0" : "") + to_string(tempUserMinInt); // Format minutes as two digits
-                        int tempUserSecInt = tempUserTimeInSeconds % 60;
-                        string tempUserSecStr = (tempUserSecInt < 10 ? "0" : "") + to_string(tempUserSecInt); // Format seconds as two digits
-                        string tempUserTime = tempUserMinStr + ":" + tempUserSecStr;
-                        string tempUser = ScoreHighVector.at(i).name;
-
-                        // Add an asterisk to the new high score if applicable
-                        if (positionOfNewWinner >= 0 && i == positionOfNewWinner) {
-                            tempUser += "*";
-                        }
+            // Close the game window if the red "X" is clicked
+            if (eventOfGame.type == Event::Closed) {
+                gameScheduler.printReport("Game window"); // Frames drawn and CPU usage of the session
 
-                        // Format the leaderboard display
-                        if (i == 0) {
-                            combiningHighscoreText += to_string(i + 1) + "\t" + tempUserTime + "\t" + tempUser;
-                        } else {
-                            combiningHighscoreText += "\n\n" + to_string(i + 1) + "\t" + tempUserTime + "\t" + tempUser;
-                        }
-                    }
+                // Save a game in progress so the next start resumes it; a finished game leaves no save behind
+                if (gameBrd.core.minesPlaced && !gameBrd.loser && !gameBrd.winner) gameBrd.save(saveFile, inputTheUser, clockOfGame.getElapsedTime());
+                else remove(saveFile.c_str());
 
-                    Text highscoreText = setTheTextObj(combiningHighscoreText, font, 18, Color::White, widthOfLB / 2.0f, (heightOfLB / 2.0f) + 20);
-                    highscoreText.setStyle(Text::Bold);
-
-                    Event eventLB;
-                    while (windowLB.pollEvent(eventLB)) { // Continuously check for events in the leaderboard window
-                        if (eventLB.type == Event::Closed) { // Close the leaderboard window if the red "X" is clicked
-                            gameBrd.leaderBoard = false;
-                            if (!gameBrd.is_paused && !gameBrd.loser && !gameBrd.winner) {
-                                gameBrd.enableAllTiles(); // Re-enable game tile interactions
-                                clockOfGame.start(); // Resume the game clock
-                            }
-                            windowLB.close();
-                        }
-                    }
+                // Close the game in the log and write it (a resumed game appends to it next time)
+                gameLog.end(gameBrd, clockOfGame.getElapsedTime().asMicroseconds());
+                if (gameLog.write(logFile)) cout << "Replay log of " << gameLog.size() << " bytes written to " << logFile << endl;
+                if (TRACE_ENABLED && writeChromeTrace(traceFile)) cout << "Trace of " << traceEventCount() << " events written to " << traceFile << endl;
+                gameWindow.close();
+                return 0;
+            }
 
-                    // Update and display leaderboard content
-                    windowLB.draw(LBText);
-                    windowLB.draw(highscoreText);
-                    windowLB.display();
+            // Handle the solver keys when the leaderboard is not active (the solver works on flat boards only)
+            if (eventOfGame.type == Event::KeyPressed && !gameBrd.leaderBoard && !gameBrd.endlessMode) {
+                if (eventOfGame.key.code == Keyboard::H) { // Hint: outline a provably safe tile (or a provable mine)
+                    gameBrd.solver.solve(gameBrd.core);
+                    hintTile = gameBrd.solver.nextSafeTile(gameBrd.core);
+                    if (hintTile < 0) hintTile = gameBrd.solver.nextMineTile(gameBrd.core);
+                    if (hintTile >= 0) cout << "Hint at position (" << (hintTile % gameBrd.columns) << ", " << (hintTile / gameBrd.columns) << ")" << endl;
+                    else cout << "No provably safe move" << endl;
+                } else if (eventOfGame.key.code == Keyboard::A) { // Toggle auto-play of provably safe moves
+                    autoPlay = !autoPlay;
+                    cout << "Auto-play " << (autoPlay ? "on" : "off") << endl;
                 }
             }
 
-            // Close the game window if the red "X" is clicked
-            if (eventOfGame.type == Event::Closed) {
-                gameBrd.clear();
-                gameWindow.close();
-                return 0;
+            // Camera controls: the wheel zooms around the mouse, the middle button drags the view,
+            // the arrow keys pan by a quarter of the window, Home resets the view and M toggles the minimap
+            if (eventOfGame.type == Event::MouseWheelScrolled) {
+                Vector2i wheelPixel(eventOfGame.mouseWheelScroll.x, eventOfGame.mouseWheelScroll.y);
+                if (camera.contains(wheelPixel)) camera.zoomAt(wheelPixel, eventOfGame.mouseWheelScroll.delta > 0 ? 0.8f : 1.25f);
+            } else if (eventOfGame.type == Event::MouseButtonPressed && eventOfGame.mouseButton.button == Mouse::Middle) {
+                draggingView = true;
+                lastDragPixel = Vector2i(eventOfGame.mouseButton.x, eventOfGame.mouseButton.y);
+            } else if (eventOfGame.type == Event::MouseButtonReleased && eventOfGame.mouseButton.button == Mouse::Middle) {
+                draggingView = false;
+            } else if (eventOfGame.type == Event::MouseMoved && draggingView) {
+                Vector2i dragPixel(eventOfGame.mouseMove.x, eventOfGame.mouseMove.y);
+                camera.pan(Vector2f(dragPixel - lastDragPixel));
+                lastDragPixel = dragPixel;
+                gameScheduler.invalidate(); // Mouse movement only redraws while dragging
+            } else if (eventOfGame.type == Event::KeyPressed) {
+                if (eventOfGame.key.code == Keyboard::Left) camera.pan(Vector2f(widthOfWindow / 4.0f, 0));
+                else if (eventOfGame.key.code == Keyboard::Right) camera.pan(Vector2f(-widthOfWindow / 4.0f, 0));
+                else if (eventOfGame.key.code == Keyboard::Up) camera.pan(Vector2f(0, heightOfBoardArea / 4.0f));
+                else if (eventOfGame.key.code == Keyboard::Down) camera.pan(Vector2f(0, -heightOfBoardArea / 4.0f));
+                else if (eventOfGame.key.code == Keyboard::Home) camera.reset();
+                else if (eventOfGame.key.code == Keyboard::M) showMinimap = !showMinimap;
+                else if (eventOfGame.key.code == Keyboard::F3) frameOverlay.visible = !frameOverlay.visible;
             }
 
             // Handle mouse clicks when the leaderboard is not active
             if (eventOfGame.type == Event::MouseButtonPressed && !gameBrd.leaderBoard) {
-                cout << "Mouse clicked at position (" << (clickPositionWindow.x / 32) << ", " << (clickPositionWindow.y / 32) << ")" << endl;
+                Vector2i clickPositionWindow(eventOfGame.mouseButton.x, eventOfGame.mouseButton.y); // Pixel coordinates of the click
+
+                // A left click on the minimap moves the camera there instead of touching a tile
+                bool clickedMinimap = showMinimap && !gameBrd.endlessMode && !camera.showsWholeBoard() && gameBrd.minimap.contains(Vector2f(clickPositionWindow));
+                if (clickedMinimap && eventOfGame.mouseButton.button == sf::Mouse::Left) camera.centerOn(gameBrd.minimap.worldAt(Vector2f(clickPositionWindow)));
+
+                // Find the clicked tile through the camera and the clicked button from the hit-region table
+                int clickedTile = camera.contains(clickPositionWindow) && !clickedMinimap && !gameBrd.endlessMode ? gameBrd.tileAt(gameWindow, clickPositionWindow, camera.getView()) : -1; // -1 when off the board
+                bool clickedEndlessTile = camera.contains(clickPositionWindow) && gameBrd.endlessMode; // Endless tiles are found by coordinates instead
+                Vector2i clickedCoordinates = gameBrd.tileCoordinatesAt(gameWindow, clickPositionWindow, camera.getView());
+                int clickedButton = buttonAt(buttonRegions, gameWindow.mapPixelToCoords(clickPositionWindow, gameWindow.getDefaultView()));
 
                 if (eventOfGame.mouseButton.button == sf::Mouse::Left) { // Handle left mouse button clicks
 
-                    // Check all tiles in the game board for a click
-                    for (unsigned i = 0; i < gameBrd.boardPointer2D.size(); i++) {
-                        for (unsigned j = 0; j < gameBrd.boardPointer2D.at(i)->size(); j++) {
-
-                            // If a tile is clicked and enabled, determine if it's a mine or not
-                            if (gameBrd.boardPointer2D.at(i)->at(j)->sprite.getGlobalBounds().contains(clickWindow) && gameBrd.boardPointer2D.at(i)->at(j)->tile_enabled) {
-
-                                // Reveal the tile if it's not a mine, not flagged, and valid to interact
-                                if (!gameBrd.is_paused && !gameBrd.is_debugMode && !gameBrd.leaderBoard && !gameBrd.boardPointer2D.at(i)->at(j)->tile_mine && !gameBrd.boardPointer2D.at(i)->at(j)->tile_flagged) {
-                                    gameBrd.reveal(gameWindow, gameBrd.boardPointer2D.at(i)->at(j)); // Recursive reveal
-                                }
-                                // Handle mine click (loss scenario)
-                                else if (gameBrd.boardPointer2D.at(i)->at(j)->tile_mine && !gameBrd.boardPointer2D.at(i)->at(j)->tile_flagged) {
-                                    cout << "You Lost!" << endl;
-                                    textureOfFace.loadFromFile("files/images/face_lose.png"); // Change face to "dead"
-                                    clockOfGame.stop(); // Stop the game clock
-                                    gameBrd.loser = true;
-                                    gameBrd.disableTiles();
-                                    enabledDB = false;
-                                    enabledPB = false;
-                                }
-                            }
+                    // If a tile is clicked and enabled, reveal it through the engine (which also detects a mine hit)
+                    if (clickedTile >= 0 && gameBrd.core.isEnabled(clickedTile)) {
+
+                        // Reveal the tile if it's not flagged and valid to interact
+                        if (!gameBrd.is_paused && !gameBrd.is_debugMode && !gameBrd.leaderBoard && !gameBrd.core.isFlagged(clickedTile)) {
+                            if (gameBrd.chooseLayout(clickedTile)) gameLog.record(EVENT_LAYOUT, gameBrd.layoutCandidate + 1); // Timed: the replayer needs the outcome
+                            gameLog.record(EVENT_REVEAL, clickedTile);
+                            gameBrd.reveal(clickedTile); // Flood-fill reveal (timed by Board::reveal's trace scope)
                         }
                     }
 
+                    // The same for a tile of an endless board (the board ignores flagged tiles)
+                    if (clickedEndlessTile && gameBrd.endless.enabled && !gameBrd.is_paused && !gameBrd.is_debugMode && !gameBrd.leaderBoard) {
+                        gameBrd.revealAt(clickedCoordinates.x, clickedCoordinates.y); // Timed by Board::revealAt's trace scope
+                    }
+
                     // Restart the game if the face button is clicked
-                    if (spriteFaceSym.getGlobalBounds().contains(clickWindow)) {
+                    if (clickedButton == BUTTON_FACE) {
                         cout << "RESTARTING" << endl;
 
-                        if (gameBrd.loser) gameBrd.loser = false; // Reset loser state
-                        if (gameBrd.winner) gameBrd.winner = false; // Reset winner state
-
-                        Board newGameBoard; // Create a new game board
-                        gameBrd.clear(); // Clear memory from the old board
-                        gameBrd = newGameBoard; // Set the current board to the new one
-                        textureOfFace.loadFromFile("files/images/face_happy.png"); // Reset face to "happy"
+                        gameLog.end(gameBrd, clockOfGame.getElapsedTime().asMicroseconds()); // Close the old game in the log
+                        BoardConfig newConfig = readBoardConfig();
+                        gameBrd.restart(newConfig, nextGameSeed(), &boardQueue); // New game (fresh win and lose states) on a queued or reset board
+                        if (!gameBrd.endlessMode) gameLog.newGame(newConfig, gameBrd.seed); // Endless games are not logged
+
+                        // The config may have changed: wins now go to (and the leaderboard shows) the new difficulty
+                        string newDifficulty = difficultyKey(BoardConfig{gameBrd.columns, gameBrd.rows, gameBrd.mineCount, gameBrd.generationMode});
+                        if (newDifficulty != difficulty) positionOfNewWinner = -1; // The marked score belongs to the old leaderboard
+                        difficulty = newDifficulty;
+                        ScoreHighVector = leaderboardStore.board(difficulty).top(5);
+                        highscoreText.setString(formatLeaderboardText(ScoreHighVector, positionOfNewWinner));
+                        camera = BoardCamera(widthOfWindow, heightOfBoardArea, widthOfWindow, heightOfWindow, gameBrd.columns, gameBrd.rows, gameBrd.endlessMode);
+                        spriteFaceSym.setTexture(textureCache.get("files/images/face_happy.png")); // Reset face to "happy"
                         clockOfGame.restart(); // Restart the game clock
                         clockOfGame.start();
                         enabledPB = true;
                         enabledDB = true;
+                        winRecorded = false;
+                        lossRecorded = false;
+                        hintTile = -1;
                     }
 
                     // Toggle debug mode if the debug button is clicked
-                    if (spriteDebugSym.getGlobalBounds().contains(clickWindow) && enabledDB) {
+                    if (clickedButton == BUTTON_DEBUG && enabledDB) {
                         cout << "Debug button pressed" << endl;
+                        gameLog.record(EVENT_DEBUG);
                         gameBrd.toggleDebugMode();
                         if (gameBrd.is_debugMode) gameBrd.disableTiles(); // Disable interactions in debug mode
                         else gameBrd.enableAllTiles();
                     }
 
                     // Toggle pause mode if the pause button is clicked
-                    if (spritePause.getGlobalBounds().contains(clickWindow) && enabledPB) {
+                    if (clickedButton == BUTTON_PAUSE && enabledPB) {
+                        gameLog.record(EVENT_PAUSE);
                         if (clockOfGame.isPaused()) clockOfGame.start();
                         else clockOfGame.stop();
                         cout << "Pause button pressed" << endl;
@@ -409,18 +435,19 @@ int main(){
                             clockOfGame.stop();
                             gameBrd.disableTiles();
                             enabledDB = false;
-                            textPause.loadFromFile("files/images/play.png"); // Change icon to "play"
+                            spritePause.setTexture(textureCache.get("files/images/play.png")); // Change icon to "play"
                         } else {
                             gameBrd.enableAllTiles();
                             enabledDB = true;
                             clockOfGame.start();
-                            textPause.loadFromFile("files/images/pause.png"); // Change icon to "pause"
+                            spritePause.setTexture(textureCache.get("files/images/pause.png")); // Change icon to "pause"
                         }
                     }
 
                     // Open leaderboard if the leaderboard button is clicked
-                    if (spriteLB.getGlobalBounds().contains(clickWindow)) {
+                    if (clickedButton == BUTTON_LEADERBOARD) {
                         cout << "Leaderboard button pressed" << endl;
+                        gameLog.record(EVENT_LEADERBOARD_OPEN);
                         clockOfGame.stop(); // Stop the game clock
                         gameBrd.disableTiles(); // Disable interactions
                         gameBrd.toggleOfLB();
@@ -430,113 +457,183 @@ int main(){
                 // Handle right mouse button clicks (flagging tiles)
                 else if (eventOfGame.mouseButton.button == sf::Mouse::Right) {
 
-                    // Check all tiles in the game board for a click
-                    for (unsigned i = 0; i < gameBrd.boardPointer2D.size(); i++) {
-                        for (unsigned j = 0; j < gameBrd.boardPointer2D.at(i)->size(); j++) {
-
-                            // Only allow flagging if the game is in a valid state
-                            if (gameBrd.boardPointer2D.at(i)->at(j)->sprite.getGlobalBounds().contains(clickWindow) && !gameBrd.is_paused && !gameBrd.is_debugMode && !gameBrd.loser && !gameBrd.winner) {
-
-                                // Place a flag if the tile is not already flagged or revealed
-                                if (!gameBrd.boardPointer2D.at(i)->at(j)->tile_flagged && !gameBrd.boardPointer2D.at(i)->at(j)->tile_revealed) {
-                                    gameBrd.placeFlagging--; // Decrement the mine counter
-                                    gameBrd.boardPointer2D.at(i)->at(j)->toggleFlag();
-                                }
-
-                                // Remove a flag if it is already flagged and valid
-                                else if (gameBrd.boardPointer2D.at(i)->at(j)->tile_flagged && !gameBrd.boardPointer2D.at(i)->at(j)->tile_revealed) {
-                                    gameBrd.placeFlagging++; // Increment the mine counter
-                                    gameBrd.boardPointer2D.at(i)->at(j)->toggleFlag();
-                                }
-                            }
-                        }
+                    // Only allow flagging if the game is in a valid state (the engine only flags hidden tiles
+                    // while the game is running, and keeps the flag counter up to date)
+                    if (clickedTile >= 0 && !gameBrd.is_paused && !gameBrd.is_debugMode) {
+                        if (gameBrd.toggleFlag(clickedTile)) gameLog.record(EVENT_FLAG, clickedTile);
                     }
+                    if (clickedEndlessTile && !gameBrd.is_paused && !gameBrd.is_debugMode) gameBrd.toggleFlagAt(clickedCoordinates.x, clickedCoordinates.y);
                 }
             }
         }
 
 
-        // Check if the user has won the game
+        // Auto-play: reveal one provably safe tile (or flag one provable mine) per frame while the game runs
+        if (autoPlay && gameBrd.core.minesPlaced && !gameBrd.is_paused && !gameBrd.is_debugMode && !gameBrd.leaderBoard && !gameBrd.loser && !gameBrd.winner) {
+            gameBrd.solver.solve(gameBrd.core);
+            int safeTile = gameBrd.solver.nextSafeTile(gameBrd.core);
+            int mineTile = gameBrd.solver.nextMineTile(gameBrd.core);
+            if (safeTile >= 0) {
+                gameLog.record(EVENT_REVEAL, safeTile);
+                gameBrd.reveal(safeTile);
+            } else if (mineTile >= 0 && gameBrd.toggleFlag(mineTile)) {
+                gameLog.record(EVENT_FLAG, mineTile);
+            }
+            if (safeTile >= 0 || mineTile >= 0) gameScheduler.invalidate(); // Show the move (auto-play then runs at the frame cap)
+        }
+
+        // Check if the user has lost the game (the engine sets the loser state when a mine is revealed)
+        if (gameBrd.loser && !lossRecorded) {
+            lossRecorded = true;
+            gameScheduler.invalidate();
+            cout << "You Lost!" << endl;
+            spriteFaceSym.setTexture(textureCache.get("files/images/face_lose.png")); // Change face to "dead"
+            clockOfGame.stop(); // Stop the game clock
+            gameBrd.disableTiles();
+            enabledDB = false;
+            enabledPB = false;
+        }
+
+        // Calculate the current game time in minutes and seconds
+        int minsInCurrentUser = clockOfGame.getElapsedTime().asSeconds() / 60;
+        int secsInCurrentUser = ((int)clockOfGame.getElapsedTime().asSeconds()) % 60;
+
+        // Check if the user has won the game (the engine sets the winner state when the last safe tile is revealed)
         if (gameBrd.checkIfWinner()) {
             clockOfGame.stop(); // Stop the game clock to record the most accurate time
-            gameBrd.placeFlagging = 0; // Reset flags as per the game instructions
 
-            if (!gameBrd.winner) { // Ensure the leaderboard window appears only once after winning
+            if (!winRecorded) { // Ensure the leaderboard window appears only once after winning
+                winRecorded = true;
+                gameScheduler.invalidate();
                 gameBrd.leaderBoard = true; // Activate leaderboard display
 
-                // Determine if the user's score qualifies for the leaderboard
-                positionOfNewWinner = -1; // Default to no new high score (indicated by -1)
+                // Record the win (appended to the leaderboard file) and find its place in the top five
+                positionOfNewWinner = leaderboardStore.addScore(difficulty, secsInCurrentUser + (minsInCurrentUser * 60), inputTheUser);
+                ScoreHighVector = leaderboardStore.board(difficulty).top(5);
+                highscoreText.setString(formatLeaderboardText(ScoreHighVector, positionOfNewWinner)); // Invalidate the leaderboard text
 
-                // Fetch the fifth place from the active leaderboard and the last place in the complete leaderboard
-                Player playerInFifth = ScoreHighVector.back();
-                Player playerInLast = allHighFileVector.back();
+                // Update UI components for the win
+                spriteFaceSym.setTexture(textureCache.get("files/images/face_win.png")); // Display the winning face
+                gameBrd.disableTiles(); // Disable further tile interactions
+                enabledDB = false; // Disable debug button
+                enabledPB = false; // Disable pause button
+            }
+        }
 
-                // Create a new Player object for the current winner
-                Player tempPlayer;
-                tempPlayer.name = inputTheUser; // Assign the user's name
-                tempPlayer.secondsTime = secsInCurrentUser + (minsInCurrentUser * 60); // Convert elapsed time to total seconds
+        gameScheduler.timerShows(secsInCurrentUser + (minsInCurrentUser * 60)); // Redraw when the timer shows a new second
 
-                // Check if the user's time is better than the fifth place on the active leaderboard
-                if (tempPlayer.secondsTime < playerInFifth.secondsTime) {
-                    ScoreHighVector.pop_back(); // Remove the slowest score from the active leaderboard
+        // Skip drawing until something changed (and the frame cap allows it)
+        if (!gameScheduler.shouldDraw()) continue;
 
-                    // Insert the new high score into the appropriate position (top 1-4)
-                    for (auto iter = ScoreHighVector.begin(); iter != ScoreHighVector.end(); iter++) {
-                        positionOfNewWinner++; // Increment the position for potential insertion
-                        if (tempPlayer.secondsTime < iter->secondsTime) {
-                            ScoreHighVector.insert(iter, tempPlayer); // Insert the new score
-                            break;
-                        }
-                    }
+        int64_t frameStart = TRACE_ENABLED ? traceNow() : 0; // The leaderboard window below is not part of the frame
+        frameOverlay.frameStarted();
+        gameWindow.clear(Color::White); // Clear the window with a white background
+        gameWindow.setView(camera.getView()); // The board and the hint outline follow the camera
+        gameBrd.draw(gameWindow, camera.visibleTiles()); // Render the visible part of the game board
+
+        // Outline the hinted tile until it is revealed or flagged
+        if (hintTile >= 0 && (gameBrd.core.isRevealed(hintTile) || gameBrd.core.isFlagged(hintTile))) hintTile = -1;
+        if (hintTile >= 0 && !gameBrd.is_paused && !gameBrd.leaderBoard) {
+            hintOutline.setPosition((hintTile % gameBrd.columns) * 32 + 2, (hintTile / gameBrd.columns) * 32 + 2);
+            drawCounted(gameWindow, hintOutline);
+        }
+        gameWindow.setView(gameWindow.getDefaultView()); // The HUD stays in place
 
-                    // If the new high score was not inserted, add it as the fifth score
-                    if (ScoreHighVector.size() < 5) {
-                        positionOfNewWinner++; // Update the position for the fifth place
-                        ScoreHighVector.push_back(tempPlayer); // Add the new score at the end
-                    }
-                }
+        // Show where the camera is on the whole board when the board doesn't fit
+        if (showMinimap && !gameBrd.endlessMode && !camera.showsWholeBoard()) gameBrd.minimap.draw(gameWindow, gameBrd, Vector2f(widthOfWindow - 8, 8), camera.worldRect());
 
-                // Insert the new high score into the full leaderboard
-                for (auto iter = allHighFileVector.begin(); iter != allHighFileVector.end(); iter++) {
-                    if (tempPlayer.secondsTime < iter->secondsTime) {
-                        allHighFileVector.insert(iter, tempPlayer); // Insert the new score
-                        break;
-                    }
-                }
+        // Display the mine count (if negative, show a negative sign)
+        if (gameBrd.placeFlagging < 0) {
+            spriteDigits[10].setPosition(12, hudTop + 16); // Display the negative sign
+            drawCounted(gameWindow, spriteDigits[10]);
+        }
 
-                // Add the new score to the end if it is the worst score so far
-                if (tempPlayer.secondsTime >= playerInLast.secondsTime) {
-                    allHighFileVector.push_back(tempPlayer);
-                }
+        // Display the mine count when positive
+        if (gameBrd.placeFlagging >= 0) {
+            int mineCountHundredsDigit = gameBrd.placeFlagging / 100; // Hundreds digit
+            spriteDigits[mineCountHundredsDigit].setPosition(33, hudTop + 16);
+            drawCounted(gameWindow, spriteDigits[mineCountHundredsDigit]);
+
+            int mineCountTensDigit = (gameBrd.placeFlagging % 100) / 10; // Tens digit
+            spriteDigits[mineCountTensDigit].setPosition(54, hudTop + 16);
+            drawCounted(gameWindow, spriteDigits[mineCountTensDigit]);
+
+            int mineCountOnesDigit = gameBrd.placeFlagging % 10; // Ones digit
+            spriteDigits[mineCountOnesDigit].setPosition(75, hudTop + 16);
+            drawCounted(gameWindow, spriteDigits[mineCountOnesDigit]);
+        } else if (gameBrd.placeFlagging < 0) { // Handle negative mine count
+            gameBrd.placeFlagging = abs(gameBrd.placeFlagging); // Temporarily convert to positive for calculations
+
+            int mineCountHundredsDigit = gameBrd.placeFlagging / 100; // Hundreds digit
+            spriteDigits[mineCountHundredsDigit].setPosition(33, hudTop + 16);
+            drawCounted(gameWindow, spriteDigits[mineCountHundredsDigit]);
 
-                // Update the leaderboard file with the latest scores
-                fileOfScoreHigh.open("files/leaderboard.txt", std::ios::out | std::ios::trunc); // Open file for overwriting
-                string tempFileMinsStr;
-                string tempFileSecsStr;
-                for (auto iter = allHighFileVector.begin(); iter != allHighFileVector.end(); iter++) {
-                    short tempFileMins = (iter->secondsTime) / 60; // Calculate minutes
-                    short tempFileSecs = (iter->secondsTime) % 60; // Calculate seconds
+            int mineCountTensDigit = (gameBrd.placeFlagging % 100) / 10; // Tens digit
+            spriteDigits[mineCountTensDigit].setPosition(54, hudTop + 16);
+            drawCounted(gameWindow, spriteDigits[mineCountTensDigit]);
+
+            int mineCountOnesDigit = gameBrd.placeFlagging % 10; // Ones digit
+            spriteDigits[mineCountOnesDigit].setPosition(75, hudTop + 16);
+            drawCounted(gameWindow, spriteDigits[mineCountOnesDigit]);
+
+            gameBrd.placeFlagging *= -1; // Revert mine count back to negative
+        }
+
+        // Set the position of the timer digits on the bottom-right corner of the screen
+        spriteDigits[minsInCurrentUser / 10].setPosition(widthOfWindow - 97, hudTop + 16); // Left digit of minutes
+        drawCounted(gameWindow, spriteDigits[minsInCurrentUser / 10]); // Draw the left minute digit immediately
+
+        spriteDigits[minsInCurrentUser % 10].setPosition(widthOfWindow - 76, hudTop + 16); // Right digit of minutes
+        drawCounted(gameWindow, spriteDigits[minsInCurrentUser % 10]); // Draw the right minute digit immediately
 
-                    // Format minutes with leading zero if needed
-                    if (tempFileMins >= 10) tempFileMinsStr = to_string(tempFileMins);
-                    else tempFileMinsStr = "0" + to_string(tempFileMins);
+        spriteDigits[secsInCurrentUser / 10].setPosition(widthOfWindow - 54, hudTop + 16); // Left digit of seconds
+        drawCounted(gameWindow, spriteDigits[secsInCurrentUser / 10]); // Draw the left second digit immediately
 
-                    // Format seconds with leading zero if needed
-                    if (tempFileSecs >= 10) tempFileSecsStr = to_string(tempFileSecs);
-                    else tempFileSecsStr = "0" + to_string(tempFileSecs);
+        spriteDigits[secsInCurrentUser % 10].setPosition(widthOfWindow - 33, hudTop + 16); // Right digit of seconds
+        drawCounted(gameWindow, spriteDigits[secsInCurrentUser % 10]); // Draw the right second digit immediately
 
-                    // Write the formatted score to the file
-                    fileOfScoreHigh << tempFileMinsStr + ":" + tempFileSecsStr + "," + iter->name << endl;
+        // Render the UI components that need updating every frame
+        drawCounted(gameWindow, spriteFaceSym); // Draw the "face" button
+        drawCounted(gameWindow, spriteDebugSym); // Draw the "debug" button
+        drawCounted(gameWindow, spritePause); // Draw the "pause" button
+        drawCounted(gameWindow, spriteLB); // Draw the "leaderboard" button
+        if (TRACE_ENABLED && frameOverlay.visible) frameOverlay.draw(gameWindow); // Frame time, draw calls and events (tracing builds)
+        gameWindow.display(); // Display the updated content on the screen
+        if (TRACE_ENABLED) traceRecord("frame", frameStart, traceNow());
+        gameScheduler.frameDrawn();
+
+        // If the leaderboard is active, create and manage the leaderboard window
+        if (gameBrd.leaderBoard) {
+            RenderWindow windowLB(VideoMode(widthOfLB, heightOfLB), "Minesweeper", sf::Style::Close);
+            RenderScheduler leaderboardScheduler(frameCap); // The scores don't change while the window is open, so it is drawn once per event
+            while (windowLB.isOpen()) {
+
+                Event eventLB;
+                bool eventWaiting = leaderboardScheduler.waitForEvent(windowLB, eventLB, leaderboardScheduler.waitTime(false, Time::Zero)); // Block until an event arrives
+                while (eventWaiting || windowLB.pollEvent(eventLB)) { // Check for events in the leaderboard window
+                    eventWaiting = false;
+                    if (eventLB.type != Event::MouseMoved) leaderboardScheduler.invalidate();
+                    if (eventLB.type == Event::Closed) { // Close the leaderboard window if the red "X" is clicked
+                        gameLog.record(EVENT_LEADERBOARD_CLOSE);
+                        gameBrd.leaderBoard = false;
+                        if (!gameBrd.is_paused && !gameBrd.loser && !gameBrd.winner) {
+                            gameBrd.enableAllTiles(); // Re-enable game tile interactions
+                            clockOfGame.start(); // Resume the game clock
+                        }
+                        windowLB.close();
+                    }
                 }
-                fileOfScoreHigh.close(); // Close the file
-            }
 
-            // Mark the game as won and update UI components
-            gameBrd.winner = true; // Prevent multiple leaderboard pop-ups
-            textureOfFace.loadFromFile("files/images/face_win.png"); // Display the winning face
-            gameBrd.disableTiles(); // Disable further tile interactions
-            enabledDB = false; // Disable debug button
-            enabledPB = false; // Disable pause button
+                // Update and display leaderboard content when it needs a new frame
+                if (leaderboardScheduler.shouldDraw()) {
+                    windowLB.clear(Color::Blue); // Set the leaderboard window background to blue
+                    LBText.draw(windowLB);
+                    highscoreText.draw(windowLB);
+                    windowLB.display();
+                    leaderboardScheduler.frameDrawn();
+                }
+            }
+            gameScheduler.invalidate(); // Redraw the game window once the leaderboard closes
         }
     }
     return 0;
@@ -0,0 +1,169 @@
+#include "saveGame.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// Bits of the status field in the header
+const uint32_t SAVE_MINES_PLACED = 1;
+const uint32_t SAVE_LOSER = 2;
+const uint32_t SAVE_WINNER = 4;
+
+// The fixed-size part of the file, written field by field so the layout doesn't depend on padding
+struct SaveHeader {
+    char magic[4];
+    uint32_t version;
+    int32_t rows;
+    int32_t columns;
+    int32_t mineCount;
+    int32_t generationMode;
+    int32_t placeFlagging;
+    uint32_t status;
+    int64_t elapsedMicroseconds;
+    uint32_t nameLength;
+};
+const size_t SAVE_HEADER_SIZE = 4 + 4 * 7 + 8 + 4;
+
+// Counters contributed by the two tiles of one packed byte
+struct PairCounts {
+    uint8_t revealedSafe;
+    uint8_t flagged;
+    uint8_t flaggedMines;
+};
+
+// Returns the counters of every possible packed byte, so the load can keep the running
+// counters up to date with one table lookup per two tiles instead of a second pass
+static const PairCounts* pairCountTable() {
+    static PairCounts table[256];
+    static bool built = false;
+    if (!built) {
+        for (int packed = 0; packed < 256; packed++) {
+            PairCounts counts = {0, 0, 0};
+            for (uint8_t tile : {(uint8_t)(packed << 4), (uint8_t)(packed & 0xF0)}) {
+                counts.revealedSafe += (tile & (TILE_MINE | TILE_REVEALED)) == TILE_REVEALED;
+                counts.flagged += (tile & TILE_FLAGGED) != 0;
+                counts.flaggedMines += (tile & (TILE_FLAGGED | TILE_MINE)) == (TILE_FLAGGED | TILE_MINE);
+            }
+            table[packed] = counts;
+        }
+        built = true;
+    }
+    return table;
+}
+
+// Appends the raw bytes of a value to the buffer
+template <typename T>
+static void put(vector<uint8_t>& buffer, const T& value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+// Copies a value out of the buffer at 'offset' and advances the offset
+template <typename T>
+static void get(const uint8_t* buffer, size_t& offset, T& value) {
+    memcpy(&value, buffer + offset, sizeof(T));
+    offset += sizeof(T);
+}
+
+// Packs the header, the name and two tiles per byte into one buffer and writes it in one call
+bool saveGame(const string& path, const GameEngine& engine, const string& playerName, int64_t elapsedMicroseconds) {
+    const vector<uint8_t>& state = engine.core.state;
+    size_t tileCount = state.size();
+
+    vector<uint8_t> buffer;
+    buffer.reserve(SAVE_HEADER_SIZE + playerName.size() + (tileCount + 1) / 2);
+    buffer.insert(buffer.end(), {'M', 'S', 'S', 'V'});
+    put(buffer, SAVE_FORMAT_VERSION);
+    put(buffer, (int32_t)engine.rows);
+    put(buffer, (int32_t)engine.columns);
+    put(buffer, (int32_t)engine.mineCount);
+    put(buffer, (int32_t)engine.generationMode);
+    put(buffer, (int32_t)engine.placeFlagging);
+    put(buffer, (uint32_t)((engine.core.minesPlaced ? SAVE_MINES_PLACED : 0) | (engine.loser ? SAVE_LOSER : 0) | (engine.winner ? SAVE_WINNER : 0)));
+    put(buffer, elapsedMicroseconds);
+    put(buffer, (uint32_t)playerName.size());
+    buffer.insert(buffer.end(), playerName.begin(), playerName.end());
+
+    // Two tiles per byte: the high nibble of each state byte (the mine count is left out)
+    size_t tilesStart = buffer.size();
+    buffer.resize(tilesStart + (tileCount + 1) / 2);
+    uint8_t* tiles = buffer.data() + tilesStart;
+    size_t pairs = tileCount / 2;
+    for (size_t i = 0; i < pairs; i++) {
+        tiles[i] = (uint8_t)((state[2 * i] >> 4) | (state[2 * i + 1] & 0xF0));
+    }
+    if (tileCount % 2) tiles[pairs] = state[tileCount - 1] >> 4;
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) return false;
+    bool written = fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+    return fclose(file) == 0 && written;
+}
+
+// Reads the whole file at once, checks the header, then unpacks the tiles and rebuilds the counts
+bool loadGame(const string& path, GameEngine& engine, string& playerName, int64_t& elapsedMicroseconds) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+    fseek(file, 0, SEEK_END);
+    long fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    vector<uint8_t> buffer(fileSize > 0 ? (size_t)fileSize : 0);
+    bool read = fileSize > 0 && fread(buffer.data(), 1, buffer.size(), file) == buffer.size();
+    fclose(file);
+    if (!read || buffer.size() < SAVE_HEADER_SIZE) return false;
+
+    SaveHeader header;
+    size_t offset = 0;
+    get(buffer.data(), offset, header.magic);
+    get(buffer.data(), offset, header.version);
+    get(buffer.data(), offset, header.rows);
+    get(buffer.data(), offset, header.columns);
+    get(buffer.data(), offset, header.mineCount);
+    get(buffer.data(), offset, header.generationMode);
+    get(buffer.data(), offset, header.placeFlagging);
+    get(buffer.data(), offset, header.status);
+    get(buffer.data(), offset, header.elapsedMicroseconds);
+    get(buffer.data(), offset, header.nameLength);
+    if (memcmp(header.magic, "MSSV", 4) != 0 || header.version != SAVE_FORMAT_VERSION) return false;
+    if (header.rows <= 0 || header.columns <= 0) return false;
+
+    size_t tileCount = (size_t)header.rows * header.columns;
+    if (buffer.size() != SAVE_HEADER_SIZE + header.nameLength + (tileCount + 1) / 2) return false; // Truncated or padded
+
+    // The file is valid: rebuild the engine at the saved size
+    engine = GameEngine(BoardConfig{header.columns, header.rows, header.mineCount, header.generationMode}, 0);
+    engine.placeFlagging = header.placeFlagging;
+    engine.loser = (header.status & SAVE_LOSER) != 0;
+    engine.winner = (header.status & SAVE_WINNER) != 0;
+    playerName.assign(reinterpret_cast<const char*>(buffer.data() + offset), header.nameLength);
+    offset += header.nameLength;
+    elapsedMicroseconds = header.elapsedMicroseconds;
+
+    // Unpack two tiles per byte straight into the state bytes, counting as we go
+    uint8_t* state = engine.core.state.data();
+    const uint8_t* tiles = buffer.data() + offset;
+    const PairCounts* counts = pairCountTable();
+    int revealedSafe = 0, flagged = 0, flaggedMines = 0;
+    size_t pairs = tileCount / 2;
+    for (size_t i = 0; i < pairs; i++) {
+        uint8_t packed = tiles[i];
+        state[2 * i] = (uint8_t)(packed << 4);
+        state[2 * i + 1] = (uint8_t)(packed & 0xF0);
+        revealedSafe += counts[packed].revealedSafe;
+        flagged += counts[packed].flagged;
+        flaggedMines += counts[packed].flaggedMines;
+    }
+    if (tileCount % 2) {
+        uint8_t packed = tiles[pairs] & 0x0F; // Only the low nibble holds a tile
+        state[tileCount - 1] = (uint8_t)(packed << 4);
+        revealedSafe += counts[packed].revealedSafe;
+        flagged += counts[packed].flagged;
+        flaggedMines += counts[packed].flaggedMines;
+    }
+    engine.core.revealedSafeTiles = revealedSafe;
+    engine.core.flagsPlaced = flagged;
+    engine.core.correctFlags = flaggedMines;
+
+    engine.core.countNearbyMines();
+    engine.core.minesPlaced = (header.status & SAVE_MINES_PLACED) != 0;
+    return true;
+}
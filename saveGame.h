@@ -0,0 +1,22 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "gameEngine.h"
+using namespace std;
+
+// Save file layout (little-endian):
+//   header     "MSSV", format version, rows, columns, mine count, generation mode, flags left,
+//              status bits (mines placed, lost, won), elapsed time in microseconds, name length
+//   name       the player's name (name length bytes)
+//   tiles      4 bits per tile, two tiles per byte (even tiles in the low nibble). The nibble is
+//              the high half of the tile's state byte (mine, flagged, revealed, enabled); the
+//              nearby-mine counts are recomputed on load instead of being stored.
+const uint32_t SAVE_FORMAT_VERSION = 1;
+
+// Writes the game to 'path' and returns whether it succeeded.
+bool saveGame(const string& path, const GameEngine& engine, const string& playerName, int64_t elapsedMicroseconds);
+
+// Reads a game saved by saveGame with a single read of the whole file and unpacks the tiles
+// directly into 'engine' (resized to the saved board). Returns false, leaving 'engine'
+// untouched, if the file is missing, truncated or not a save file.
+bool loadGame(const string& path, GameEngine& engine, string& playerName, int64_t& elapsedMicroseconds);
@@ -0,0 +1,135 @@
+#include "solver.h"
+
+// Forgets all conclusions and queues every revealed tile
+void Solver::reset(const BoardCore& core) {
+    knowledge.assign(core.state.size(), SOLVER_UNKNOWN);
+    queued.assign(core.state.size(), 0);
+    dirtyTiles.clear();
+    safeTiles.clear();
+    mineTiles.clear();
+    for (int i = 0; i < (int)core.state.size(); i++) {
+        if (core.isRevealed(i)) markDirty(core, i);
+    }
+}
+
+// Queues a revealed tile unless it is already queued
+void Solver::markDirty(const BoardCore& core, int index) {
+    if (queued[index] || !core.isRevealed(index)) return;
+    queued[index] = 1;
+    dirtyTiles.push_back(index);
+}
+
+// Queues every new tile and the revealed tiles around it (their hidden neighbors changed)
+void Solver::tilesRevealed(const BoardCore& core, const vector<int>& revealedTiles) {
+    if (knowledge.size() != core.state.size()) return; // Not used on this board yet: solve() starts from the whole board
+    for (int index : revealedTiles) {
+        markDirty(core, index);
+        core.forEachNeighbor(index, [&](int neighbor) { markDirty(core, neighbor); });
+    }
+}
+
+// Puts an unflagged proven tile back on its list (nextSafeTile and nextMineTile drop flagged ones)
+void Solver::flagToggled(const BoardCore& core, int index) {
+    if (knowledge.size() != core.state.size() || core.isFlagged(index)) return; // Not used on this board yet, or a new flag
+    if (knowledge[index] == SOLVER_SAFE) safeTiles.push_back(index);
+    else if (knowledge[index] == SOLVER_MINE) mineTiles.push_back(index);
+}
+
+// Builds "cells hold 'mines' mines" for a revealed tile, leaving out proven tiles. Flagged tiles
+// stay in as unknown cells unless proven, so a wrong flag can't lead to a wrong conclusion
+Solver::Constraint Solver::constraintOf(const BoardCore& core, int index) const {
+    Constraint constraint;
+    constraint.mines = core.nearbyMines(index);
+    core.forEachNeighbor(index, [&](int neighbor) {
+        if (core.isRevealed(neighbor)) return;
+        if (knowledge[neighbor] == SOLVER_MINE) constraint.mines--;
+        else if (knowledge[neighbor] == SOLVER_UNKNOWN) constraint.cells[constraint.cellCount++] = neighbor;
+    });
+    return constraint;
+}
+
+// Records a newly proven tile and queues the constraints that contain it
+void Solver::prove(const BoardCore& core, int index, uint8_t result) {
+    if (knowledge[index] != SOLVER_UNKNOWN) return;
+    knowledge[index] = result;
+    if (result == SOLVER_SAFE) safeTiles.push_back(index);
+    else mineTiles.push_back(index);
+    core.forEachNeighbor(index, [&](int neighbor) { markDirty(core, neighbor); });
+}
+
+// Proves the cells of 'larger' outside 'smaller' when 'smaller' is a subset of it
+void Solver::applySubsetRule(const BoardCore& core, const Constraint& smaller, const Constraint& larger) {
+    if (larger.cellCount <= smaller.cellCount) return;
+
+    // Collect the cells of the larger constraint that are not in the smaller one
+    int extra[8];
+    int extraCount = 0;
+    for (int a = 0; a < larger.cellCount; a++) {
+        bool inSmaller = false;
+        for (int b = 0; b < smaller.cellCount; b++) {
+            if (larger.cells[a] == smaller.cells[b]) inSmaller = true;
+        }
+        if (!inSmaller) extra[extraCount++] = larger.cells[a];
+    }
+    if (larger.cellCount - extraCount != smaller.cellCount) return; // Not a subset
+
+    // The extra cells hold the difference in mines
+    int extraMines = larger.mines - smaller.mines;
+    if (extraMines == 0) {
+        for (int a = 0; a < extraCount; a++) prove(core, extra[a], SOLVER_SAFE);
+    } else if (extraMines == extraCount) {
+        for (int a = 0; a < extraCount; a++) prove(core, extra[a], SOLVER_MINE);
+    }
+}
+
+// Applies the rules to one revealed tile
+void Solver::examine(const BoardCore& core, int index) {
+    Constraint own = constraintOf(core, index);
+    if (own.cellCount == 0 || own.mines < 0 || own.mines > own.cellCount) return; // Settled (nothing left to prove)
+
+    // Single-constraint rules: no mines left means all safe, as many mines as cells means all mines
+    if (own.mines == 0 || own.mines == own.cellCount) {
+        uint8_t result = own.mines == 0 ? SOLVER_SAFE : SOLVER_MINE;
+        for (int i = 0; i < own.cellCount; i++) prove(core, own.cells[i], result);
+        return;
+    }
+
+    // Subset rule in both directions against every revealed tile that can share a cell with
+    // this one (those within two steps), since either constraint may have just changed
+    int row = index / core.columns;
+    int column = index % core.columns;
+    for (int i = max(row - 2, 0); i <= min(row + 2, core.rows - 1); i++) {
+        for (int j = max(column - 2, 0); j <= min(column + 2, core.columns - 1); j++) {
+            int other = core.index(i, j);
+            if (other == index || !core.isRevealed(other)) continue;
+
+            Constraint neighbor = constraintOf(core, other);
+            if (neighbor.cellCount == 0 || neighbor.mines < 0 || neighbor.mines > neighbor.cellCount) continue;
+            applySubsetRule(core, own, neighbor);
+            applySubsetRule(core, neighbor, own);
+        }
+    }
+}
+
+// Works through the queue; proving a tile queues its neighbors, so this runs to a fixed point
+void Solver::solve(const BoardCore& core) {
+    if (knowledge.size() != core.state.size()) reset(core);
+    while (!dirtyTiles.empty()) {
+        int index = dirtyTiles.back();
+        dirtyTiles.pop_back();
+        queued[index] = 0;
+        examine(core, index);
+    }
+}
+
+// Returns a proven-safe tile that is still hidden, dropping the ones revealed since
+int Solver::nextSafeTile(const BoardCore& core) {
+    while (!safeTiles.empty() && (core.isRevealed(safeTiles.back()) || core.isFlagged(safeTiles.back()))) safeTiles.pop_back();
+    return safeTiles.empty() ? -1 : safeTiles.back();
+}
+
+// Returns a proven mine that has not been flagged yet
+int Solver::nextMineTile(const BoardCore& core) {
+    while (!mineTiles.empty() && core.isFlagged(mineTiles.back())) mineTiles.pop_back();
+    return mineTiles.empty() ? -1 : mineTiles.back();
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "boardCore.h"
+using namespace std;
+
+// What the solver has proven about a hidden tile.
+const uint8_t SOLVER_UNKNOWN = 0; // Nothing proven yet.
+const uint8_t SOLVER_SAFE = 1;    // Provably not a mine.
+const uint8_t SOLVER_MINE = 2;    // Provably a mine.
+
+// The Solver class finds hidden tiles that are provably safe or provably mines, using only
+// what the player can see: the numbers on revealed tiles. Player flags may be wrong, so a flagged
+// tile counts as a mine only once the solver has proven it is one.
+// Every revealed number is a constraint "these hidden tiles hold this many mines". The solver
+// applies the single-constraint rules (all mines / all safe) and the subset rule between pairs
+// of overlapping constraints. It is incremental: reveals and new flags only queue the
+// constraints around the changed tiles, and solve() works through that queue. Its per-tile
+// state (two bytes per tile) is only allocated by the first solve() on a board, so games that
+// never ask for a hint don't pay for it.
+class Solver {
+    // Private member variables:
+    vector<uint8_t> knowledge; // SOLVER_* state of every tile.
+    vector<int> dirtyTiles;    // Revealed tiles whose constraint must be re-examined.
+    vector<uint8_t> queued;    // Indicates whether a tile is already in dirtyTiles.
+    vector<int> safeTiles;     // Tiles proven safe (some may have been revealed since).
+    vector<int> mineTiles;     // Tiles proven to be mines (some may have been flagged since).
+
+    // A constraint: 'mines' of the tiles in 'cells' are mines.
+    struct Constraint {
+        int cells[8];
+        int cellCount = 0;
+        int mines = 0;
+    };
+
+    // Builds the constraint of a revealed tile from its number and proven tiles.
+    Constraint constraintOf(const BoardCore& core, int index) const;
+
+    // Records a proven tile and queues the revealed tiles around it.
+    void prove(const BoardCore& core, int index, uint8_t result);
+
+    // Queues a revealed tile for re-examination.
+    void markDirty(const BoardCore& core, int index);
+
+    // If every cell of 'smaller' is in 'larger', proves the remaining cells of 'larger' when they
+    // must all be safe or all be mines.
+    void applySubsetRule(const BoardCore& core, const Constraint& smaller, const Constraint& larger);
+
+    // Applies the single-constraint and subset rules to one queued tile.
+    void examine(const BoardCore& core, int index);
+
+public:
+    // Forgets everything and queues every revealed tile (used for new boards and removed flags).
+    void reset(const BoardCore& core);
+
+    // Queues the constraints affected by newly revealed tiles.
+    void tilesRevealed(const BoardCore& core, const vector<int>& revealedTiles);
+
+    // Called when a flag changes. Flags prove nothing, so no conclusion changes; a proven tile that
+    // is unflagged goes back on its list for nextSafeTile or nextMineTile.
+    void flagToggled(const BoardCore& core, int index);
+
+    // Processes queued constraints until no more tiles can be proven.
+    void solve(const BoardCore& core);
+
+    // Returns a hidden tile proven safe, or -1 if there is none.
+    int nextSafeTile(const BoardCore& core);
+
+    // Returns an unflagged tile proven to be a mine, or -1 if there is none.
+    int nextMineTile(const BoardCore& core);
+
+    // Returns what has been proven about the tile at 'index' (one of the SOLVER_* values).
+    uint8_t knowledgeOf(int index) const { return knowledge[index]; }
+};
@@ -0,0 +1,96 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "../gameLog.h"
+using namespace std;
+
+// Headless replayer: re-executes recorded game logs (files/replay.mslog from the game, or the
+// logs written by tools/simulator) against the engine as fast as it can, and checks that every
+// game ends in the logged state at the logged time.
+//
+// Usage: replayer [--repeat N] [--verbose] log...
+//   --repeat N  replays every log N times (for timing engine changes; default 1)
+//   --verbose   prints every game's seed, board and outcome
+//
+// Exits with status 1 if a log can't be read or a game doesn't replay to its logged end.
+
+// Returns the microseconds elapsed since 'start'
+double microsecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+}
+
+// Replays one decoded log; returns false at the first event that fails
+bool replay(const vector<GameEvent>& events, GameReplayer& replayer, bool verbose, string& error, size_t& failedEvent) {
+    for (size_t i = 0; i < events.size(); i++) {
+        const GameEvent& event = events[i];
+        if (!replayer.apply(event, error)) {
+            failedEvent = i;
+            return false;
+        }
+        if (verbose && event.type == EVENT_NEW_GAME) {
+            cout << "  game " << replayer.games << ": seed " << event.value << ", " << event.config.columns << "x"
+                 << event.config.rows << ", " << event.config.mineCount << " mines" << endl;
+        }
+        if (verbose && event.type == EVENT_END) {
+            const GameEngine& game = replayer.engine();
+            cout << "  game " << replayer.games << " left " << (game.winner ? "won" : game.loser ? "lost" : "in progress")
+                 << " at " << fixed << setprecision(3) << event.value / 1e6 << " s, verified" << endl;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    int repeat = 1;
+    bool verbose = false;
+    vector<string> paths;
+    for (int i = 1; i < argc; i++) {
+        string argument = argv[i];
+        if (argument == "--repeat" && i + 1 < argc) repeat = max(1, stoi(argv[++i]));
+        else if (argument == "--verbose") verbose = true;
+        else paths.push_back(argument);
+    }
+    if (paths.empty()) {
+        cerr << "Usage: replayer [--repeat N] [--verbose] log..." << endl;
+        return 1;
+    }
+
+    bool allPassed = true;
+    for (const string& path : paths) {
+        GameLog log;
+        vector<GameEvent> events;
+        if (!log.read(path) || !log.decode(events)) {
+            cout << path << ": not a readable game log" << endl;
+            allPassed = false;
+            continue;
+        }
+
+        // Replay 'repeat' times; only the first pass prints the games
+        GameReplayer replayer;
+        string error;
+        size_t failedEvent = 0;
+        bool passed = true;
+        auto start = chrono::steady_clock::now();
+        for (int pass = 0; pass < repeat && passed; pass++) {
+            replayer = GameReplayer();
+            passed = replay(events, replayer, verbose && pass == 0, error, failedEvent);
+        }
+        double seconds = microsecondsSince(start) / 1e6;
+
+        if (!passed) {
+            cout << path << ": FAILED at event " << failedEvent << " (time " << events[failedEvent].time << " us): " << error << endl;
+            allPassed = false;
+            continue;
+        }
+        double eventsReplayed = (double)events.size() * repeat;
+        cout << path << ": " << replayer.games << " games, " << events.size() << " events, " << log.size() << " bytes ("
+             << fixed << setprecision(2) << (events.empty() ? 0.0 : (double)log.size() / events.size()) << " bytes per event), "
+             << replayer.checks << " game ends verified" << endl;
+        cout << "  replayed " << repeat << "x in " << setprecision(3) << seconds << " s (" << setprecision(0)
+             << (seconds > 0 ? eventsReplayed / seconds : 0) << " events/s)" << endl;
+    }
+    return allPassed ? 0 : 1;
+}
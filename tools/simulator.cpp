@@ -0,0 +1,220 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../gameEngine.h"
+#include "../solver.h"
+#include "../gameLog.h"
+#include "../trace.h"
+using namespace std;
+
+// Monte Carlo simulator: plays complete games headlessly on every core and reports the win
+// rate, throughput, reveal and flood-fill statistics and per-game latency percentiles.
+//
+// Usage: simulator [games] [threads] [config file] [seed] [log prefix]
+//   games        number of games to play (default 1000000)
+//   threads      worker threads (default: every hardware thread)
+//   config file  board settings in the files/config.cfg format (default files/config.cfg)
+//   seed         base seed (default 1)
+//   log prefix   when given, every game is recorded and thread t writes <log prefix>-<t>.mslog,
+//                which tools/replayer verifies (e.g. against an engine change)
+//
+// Built with TRACEFLAGS=-DMS_TRACE, it also writes the engine's traced scopes, one track per
+// thread, to simulator-trace.json (the newest TRACE_RING_EVENTS of each thread).
+//
+// Each game draws its board and its guesses from its own random stream (streamSeed(seed, game)),
+// so the results for a given seed are the same whatever the thread count.
+//
+// Policy: the first click is the centre tile; after that the solver's proven safe tiles are
+// revealed and proven mines flagged, and when nothing is provable a random hidden tile that is
+// not known to be a mine is guessed.
+
+// Counters gathered by one worker thread (merged at the end)
+struct SimulationStats {
+    long long games = 0;
+    long long wins = 0;
+    long long reveals = 0;       // Reveal calls, including the first click and guesses
+    long long tilesRevealed = 0; // Tiles opened by those reveals
+    long long floodFills = 0;    // Reveals that opened more than one tile
+    long long guesses = 0;       // Reveals made without a proof
+    long long flags = 0;         // Proven mines flagged
+    vector<float> gameMicros;    // Wall time of every game
+};
+
+// Returns the microseconds elapsed since 'start'
+double microsecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+}
+
+// Reveals 'index' and updates the solver and the reveal counters; returns the log time of the reveal
+int64_t revealTile(GameEngine& engine, Solver& solver, int index, vector<int>& revealedTiles, SimulationStats& stats, GameLog* log) {
+    if (engine.chooseLayout(index) && log) log->record(EVENT_LAYOUT, engine.layoutCandidate + 1);
+    int64_t time = log ? log->record(EVENT_REVEAL, index) : 0;
+    revealedTiles.clear();
+    engine.reveal(index, revealedTiles);
+    solver.tilesRevealed(engine.core, revealedTiles);
+    stats.reveals++;
+    stats.tilesRevealed += revealedTiles.size();
+    if (revealedTiles.size() > 1) stats.floodFills++;
+    return time;
+}
+
+// Plays one complete game with the given seed, recording it in 'log' if there is one
+void playGame(const BoardConfig& config, uint32_t seed, vector<int>& revealedTiles, vector<int>& candidates, SimulationStats& stats, GameLog* log) {
+    auto start = chrono::steady_clock::now();
+    GameEngine engine(config, seed);
+    Solver solver;
+    mt19937 guessRng(seed ^ 0x5bd1e995u); // The guesses use their own stream so they don't shift the board layout
+
+    // The game clock runs from the start of the game to the reveal that ends it
+    int64_t gameStart = log ? log->newGame(config, seed) : 0;
+    int64_t lastReveal = revealTile(engine, solver, engine.core.index(engine.rows / 2, engine.columns / 2), revealedTiles, stats, log);
+
+    while (!engine.winner && !engine.loser) {
+        solver.solve(engine.core);
+        int safeTile = solver.nextSafeTile(engine.core);
+        if (safeTile >= 0) {
+            lastReveal = revealTile(engine, solver, safeTile, revealedTiles, stats, log);
+            continue;
+        }
+
+        int mineTile = solver.nextMineTile(engine.core);
+        if (mineTile >= 0) {
+            if (log) log->record(EVENT_FLAG, mineTile);
+            engine.toggleFlag(mineTile);
+            solver.flagToggled(engine.core, mineTile);
+            stats.flags++;
+            continue;
+        }
+
+        // Nothing is provable: guess among the hidden tiles not known to be mines
+        candidates.clear();
+        for (int i = 0; i < engine.tiles; i++) {
+            if (!engine.core.isRevealed(i) && !engine.core.isFlagged(i) && solver.knowledgeOf(i) != SOLVER_MINE) candidates.push_back(i);
+        }
+        lastReveal = revealTile(engine, solver, candidates[guessRng() % candidates.size()], revealedTiles, stats, log);
+        stats.guesses++;
+    }
+    if (log) {
+        engine.disableTiles(); // As the game window does when a game ends, so the logged state matches a replay
+        log->end(engine, lastReveal - gameStart);
+    }
+
+    stats.games++;
+    if (engine.winner) stats.wins++;
+    stats.gameMicros.push_back((float)microsecondsSince(start));
+}
+
+// Returns the value at percentile 'p' (0-100) of sorted samples
+double percentile(const vector<float>& sorted, double p) {
+    size_t at = min(sorted.size() - 1, (size_t)(sorted.size() * p / 100.0));
+    return sorted[at];
+}
+
+int main(int argc, char* argv[]) {
+    const char* usage = "Usage: simulator [games] [threads] [config file] [seed] [log prefix] (games must be at least 1)";
+    long long gameCount = 1000000;
+    int threadCount = (int)thread::hardware_concurrency();
+    string configPath = argc > 3 ? argv[3] : "files/config.cfg";
+    uint64_t seed = 1;
+    string logPrefix = argc > 5 ? argv[5] : "";
+    try {
+        if (argc > 1) gameCount = stoll(argv[1]);
+        if (argc > 2) threadCount = stoi(argv[2]);
+        if (argc > 4) seed = stoull(argv[4]);
+    } catch (const logic_error&) { // invalid_argument or out_of_range: a count or seed that isn't a number
+        cerr << usage << endl;
+        return 1;
+    }
+    if (threadCount < 1) threadCount = 1;
+    if (gameCount < 1) {
+        cerr << usage << endl;
+        return 1;
+    }
+
+    if (!ifstream(configPath)) {
+        cerr << "Cannot open " << configPath << endl;
+        return 1;
+    }
+    BoardConfig config = readBoardConfig(configPath);
+
+    // Workers take games in batches from a shared counter, so fast threads pick up the slack
+    const long long batchSize = 256;
+    atomic<long long> nextGame(0);
+    vector<SimulationStats> threadStats(threadCount);
+    vector<GameLog> threadLogs(logPrefix.empty() ? 0 : threadCount);
+    vector<thread> workers;
+
+    auto start = chrono::steady_clock::now();
+    for (int t = 0; t < threadCount; t++) {
+        workers.emplace_back([&, t]() {
+            SimulationStats& stats = threadStats[t];
+            vector<int> revealedTiles, candidates;
+            GameLog* log = logPrefix.empty() ? nullptr : &threadLogs[t];
+            while (true) {
+                long long first = nextGame.fetch_add(batchSize);
+                if (first >= gameCount) break;
+                long long last = min(gameCount, first + batchSize);
+                for (long long game = first; game < last; game++) {
+                    playGame(config, streamSeed(seed, game), revealedTiles, candidates, stats, log);
+                }
+            }
+        });
+    }
+    for (thread& worker : workers) worker.join();
+    double seconds = microsecondsSince(start) / 1e6;
+
+    // Write the game logs (one per thread)
+    size_t logBytes = 0;
+    for (int t = 0; t < (int)threadLogs.size(); t++) {
+        string path = logPrefix + "-" + to_string(t) + ".mslog";
+        if (!threadLogs[t].write(path)) {
+            cerr << "Cannot write " << path << endl;
+            return 1;
+        }
+        logBytes += threadLogs[t].size();
+    }
+
+    // Merge the per-thread counters
+    SimulationStats total;
+    for (SimulationStats& stats : threadStats) {
+        total.games += stats.games;
+        total.wins += stats.wins;
+        total.reveals += stats.reveals;
+        total.tilesRevealed += stats.tilesRevealed;
+        total.floodFills += stats.floodFills;
+        total.guesses += stats.guesses;
+        total.flags += stats.flags;
+        total.gameMicros.insert(total.gameMicros.end(), stats.gameMicros.begin(), stats.gameMicros.end());
+    }
+    sort(total.gameMicros.begin(), total.gameMicros.end());
+
+    double games = (double)total.games;
+    cout << "Board:             " << config.columns << "x" << config.rows << ", " << config.mineCount << " mines" << endl;
+    cout << "Games:             " << total.games << " on " << threadCount << " threads in " << fixed << setprecision(2) << seconds << " s" << endl;
+    cout << "Win rate:          " << setprecision(2) << 100.0 * total.wins / games << " %" << endl;
+    cout << "Throughput:        " << setprecision(0) << games / seconds << " games/s" << endl;
+    cout << "Reveals per game:  " << setprecision(2) << total.reveals / games << endl;
+    cout << "Tiles per reveal:  " << setprecision(2) << (double)total.tilesRevealed / total.reveals << endl;
+    cout << "Flood fills:       " << setprecision(2) << 100.0 * total.floodFills / total.reveals << " % of reveals" << endl;
+    cout << "Guesses per game:  " << setprecision(2) << total.guesses / games << endl;
+    cout << "Flags per game:    " << setprecision(2) << total.flags / games << endl;
+    cout << "Game latency (us): p50 " << setprecision(1) << percentile(total.gameMicros, 50) << ", p90 "
+         << percentile(total.gameMicros, 90) << ", p99 " << percentile(total.gameMicros, 99) << ", max "
+         << total.gameMicros.back() << endl;
+    if (!threadLogs.empty()) {
+        cout << "Game logs:         " << threadLogs.size() << " files, " << logBytes << " bytes (" << setprecision(1)
+             << (double)logBytes / games << " bytes per game)" << endl;
+    }
+    if (TRACE_ENABLED && writeChromeTrace("simulator-trace.json")) {
+        cout << "Trace:             " << traceEventCount() << " events written to simulator-trace.json" << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include "trace.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// The TraceRing struct is one thread's circular buffer of events.
+struct TraceRing {
+    vector<TraceEvent> events = vector<TraceEvent>(TRACE_RING_EVENTS);
+    atomic<uint64_t> written{0}; // Events written so far (the newest is at (written - 1) % TRACE_RING_EVENTS).
+    int thread = 0;              // Track number in the exported trace (threads in order of their first event).
+};
+
+static const chrono::steady_clock::time_point traceOrigin = chrono::steady_clock::now();
+static mutex ringsMutex;                 // Guards 'rings' (taken once per thread, and by the export).
+static vector<unique_ptr<TraceRing>> rings; // Every thread's ring, kept after the thread ends so its events can be exported.
+
+// Returns the calling thread's ring, registering a new one on its first event
+static TraceRing& threadRing() {
+    thread_local TraceRing* ring = nullptr;
+    if (!ring) {
+        lock_guard<mutex> lock(ringsMutex);
+        rings.push_back(unique_ptr<TraceRing>(new TraceRing()));
+        ring = rings.back().get();
+        ring->thread = (int)rings.size() - 1;
+    }
+    return *ring;
+}
+
+// Nanoseconds on the steady clock, from the origin
+int64_t traceNow() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - traceOrigin).count();
+}
+
+// Only the owning thread writes its ring, so the write needs no lock; the release store makes
+// the event visible to an export that reads the count afterwards
+void traceRecord(const char* name, int64_t start, int64_t end) {
+    TraceRing& ring = threadRing();
+    uint64_t written = ring.written.load(memory_order_relaxed);
+    ring.events[written & (TRACE_RING_EVENTS - 1)] = TraceEvent{name, start, end - start};
+    ring.written.store(written + 1, memory_order_release);
+}
+
+// A ring holds its last TRACE_RING_EVENTS events at most
+size_t traceEventCount() {
+    lock_guard<mutex> lock(ringsMutex);
+    size_t count = 0;
+    for (const auto& ring : rings) count += (size_t)min<uint64_t>(ring->written.load(memory_order_acquire), TRACE_RING_EVENTS);
+    return count;
+}
+
+// Forgets the events but keeps the rings for their threads
+void traceClear() {
+    lock_guard<mutex> lock(ringsMutex);
+    for (auto& ring : rings) ring->written.store(0, memory_order_release);
+}
+
+// Writes a JSON string with quotes and backslashes escaped
+static void writeJsonString(ofstream& file, const char* text) {
+    file << '"';
+    for (const char* c = text; *c; c++) {
+        if (*c == '"' || *c == '\\') file << '\\';
+        file << *c;
+    }
+    file << '"';
+}
+
+// One "X" (complete) event per scope with microsecond timestamps, plus a name for every thread track
+bool writeChromeTrace(const string& path) {
+    ofstream file(path, ios::trunc);
+    if (!file) return false;
+
+    lock_guard<mutex> lock(ringsMutex);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    char timestamp[64];
+    for (const auto& ring : rings) {
+        file << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->thread
+             << ",\"args\":{\"name\":\"thread " << ring->thread << "\"}}";
+        first = false;
+
+        uint64_t written = ring->written.load(memory_order_acquire);
+        uint64_t oldest = written > TRACE_RING_EVENTS ? written - TRACE_RING_EVENTS : 0;
+        for (uint64_t i = oldest; i < written; i++) {
+            const TraceEvent& event = ring->events[i & (TRACE_RING_EVENTS - 1)];
+            file << ",\n{\"name\":";
+            writeJsonString(file, event.name);
+            snprintf(timestamp, sizeof(timestamp), ",\"ts\":%.3f,\"dur\":%.3f", event.start / 1000.0, event.duration / 1000.0);
+            file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << ring->thread << timestamp << "}";
+        }
+    }
+    file << "\n]}\n";
+    return (bool)file;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+using namespace std;
+
+// Scoped-timer tracing of the hot paths, exported as Chrome trace-event JSON (open the file in
+// chrome://tracing or https://ui.perfetto.dev). Tracing is compiled in with -DMS_TRACE (make
+// TRACEFLAGS=-DMS_TRACE); without it TRACE_SCOPE expands to nothing, so a normal build pays
+// nothing at all. A traced scope costs two clock reads and one write into the thread's ring.
+
+#ifdef MS_TRACE
+const bool TRACE_ENABLED = true;
+#else
+const bool TRACE_ENABLED = false;
+#endif
+
+const size_t TRACE_RING_EVENTS = 1 << 16; // Events kept per thread (the oldest are overwritten first); a power of two.
+
+// The TraceEvent struct is one timed scope ("complete" event in the Chrome format).
+struct TraceEvent {
+    const char* name;   // Name of the scope (a string literal, never copied).
+    int64_t start;      // Start in nanoseconds since the trace origin.
+    int64_t duration;   // Duration in nanoseconds.
+};
+
+// Returns the nanoseconds since the trace origin (the first use of the tracing layer).
+int64_t traceNow();
+
+// Records a finished scope in the calling thread's ring buffer. The first call from a thread
+// allocates its ring; a full ring overwrites its oldest events. 'name' must outlive the trace.
+void traceRecord(const char* name, int64_t start, int64_t end);
+
+// Returns the number of events held in all the rings.
+size_t traceEventCount();
+
+// Empties every ring (the rings stay allocated).
+void traceClear();
+
+// Writes the events of every ring to 'path' as Chrome trace-event JSON, one track per thread.
+// Call it while the traced threads are idle (e.g., when the game closes). Returns whether it succeeded.
+bool writeChromeTrace(const string& path);
+
+// The TraceScope class times the scope it is declared in and records it when the scope ends.
+class TraceScope {
+    const char* name; // Name of the scope.
+    int64_t start;    // Time the scope was entered.
+
+public:
+    explicit TraceScope(const char* name) : name(name), start(traceNow()) {}
+    ~TraceScope() { traceRecord(name, start, traceNow()); }
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+};
+
+// TRACE_SCOPE("name") times the rest of the enclosing block in tracing builds.
+#ifdef MS_TRACE
+#define TRACE_JOIN_NAME(a, b) a##b
+#define TRACE_SCOPE_NAME(line) TRACE_JOIN_NAME(traceScope, line)
+#define TRACE_SCOPE(name) TraceScope TRACE_SCOPE_NAME(__LINE__)(name)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#endif
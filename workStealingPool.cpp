@@ -0,0 +1,94 @@
+#include "workStealingPool.h"
+
+// Index of the pool worker running on this thread, or -1 for other threads
+static thread_local int currentWorker = -1;
+
+// Starts the worker threads, each with its own empty deque
+WorkStealingPool::WorkStealingPool(int threadCount) : queuedTasks(0), unfinishedTasks(0), nextQueue(0), stopping(false) {
+    if (threadCount < 1) threadCount = 1;
+    for (int i = 0; i < threadCount; i++) queues.push_back(make_unique<WorkerQueue>());
+    for (int i = 0; i < threadCount; i++) workers.emplace_back([this, i]() { workerLoop(i); });
+}
+
+// Wakes every worker with the stop flag set and waits for them to exit
+WorkStealingPool::~WorkStealingPool() {
+    {
+        lock_guard<mutex> guard(sleepLock);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (thread& worker : workers) worker.join();
+}
+
+// Pushes the task on the submitting worker's deque (or the next one round-robin) and wakes a sleeper
+void WorkStealingPool::submit(function<void()> task) {
+    int target = currentWorker >= 0 ? currentWorker : (int)(nextQueue++ % queues.size());
+    unfinishedTasks++;
+    {
+        lock_guard<mutex> guard(queues[target]->lock);
+        queues[target]->tasks.push_back(move(task));
+    }
+    {
+        lock_guard<mutex> guard(sleepLock);
+        queuedTasks++;
+    }
+    workAvailable.notify_one();
+}
+
+// Pops from the back of the home deque, then steals from the front of the others
+bool WorkStealingPool::runOne(int home) {
+    function<void()> task;
+    int count = (int)queues.size();
+    for (int step = 0; step < count && !task; step++) {
+        int victim = home >= 0 ? (home + step) % count : step;
+        WorkerQueue& queue = *queues[victim];
+        lock_guard<mutex> guard(queue.lock);
+        if (queue.tasks.empty()) continue;
+        if (victim == home) {
+            task = move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+    }
+    if (!task) return false;
+
+    queuedTasks--;
+    task();
+    if (--unfinishedTasks == 0) {
+        lock_guard<mutex> guard(sleepLock); // Pairs with the predicate check in wait()
+        allFinished.notify_all();
+    }
+    return true;
+}
+
+// Runs tasks until the pool stops, sleeping while every deque is empty
+void WorkStealingPool::workerLoop(int id) {
+    currentWorker = id;
+    while (true) {
+        if (runOne(id)) continue;
+        unique_lock<mutex> guard(sleepLock);
+        workAvailable.wait(guard, [this]() { return stopping || queuedTasks > 0; });
+        if (stopping) return;
+    }
+}
+
+// Helps with the queued tasks, then sleeps until the ones still running finish
+void WorkStealingPool::wait() {
+    while (unfinishedTasks > 0) {
+        if (runOne(currentWorker)) continue;
+        unique_lock<mutex> guard(sleepLock);
+        allFinished.wait(guard, [this]() { return unfinishedTasks == 0 || queuedTasks > 0; });
+    }
+}
+
+// Lazily starts the shared pool with one worker per hardware thread
+WorkStealingPool& WorkStealingPool::shared() {
+    static WorkStealingPool pool((int)thread::hardware_concurrency());
+    return pool;
+}
+
+bool WorkStealingPool::onWorkerThread() {
+    return currentWorker >= 0;
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// The WorkStealingPool class runs tasks on a fixed set of worker threads. Every worker owns a
+// deque: it takes its own tasks from the back (most recent first, still warm in cache) and,
+// when that runs dry, steals the oldest task from the front of another worker's deque, so
+// uneven tasks keep every core busy without a single shared queue becoming the bottleneck.
+class WorkStealingPool {
+    // One worker's tasks.
+    struct WorkerQueue {
+        mutex lock;
+        deque<function<void()>> tasks;
+    };
+
+    // Private member variables:
+    vector<unique_ptr<WorkerQueue>> queues; // One deque per worker.
+    vector<thread> workers;                 // The worker threads.
+    atomic<int> queuedTasks;                // Tasks waiting in the deques.
+    atomic<int> unfinishedTasks;            // Tasks submitted but not finished yet.
+    atomic<unsigned> nextQueue;             // Round-robin target for tasks submitted from outside.
+    mutex sleepLock;                        // Guards the condition variables below.
+    condition_variable workAvailable;       // Signaled when a task is submitted or the pool stops.
+    condition_variable allFinished;         // Signaled when unfinishedTasks drops to zero.
+    bool stopping;                          // Tells the workers to exit.
+
+    // Runs one task, taken from queue 'home' first or stolen from another; false if none was found.
+    bool runOne(int home);
+
+    // The loop of worker 'id'.
+    void workerLoop(int id);
+
+public:
+    // Starts 'threadCount' workers (at least one).
+    explicit WorkStealingPool(int threadCount);
+
+    // Stops and joins the workers (queued tasks are dropped).
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Queues a task. Tasks submitted by a worker go on its own deque, others are spread round-robin.
+    void submit(function<void()> task);
+
+    // Blocks until every submitted task has finished, running queued tasks on the calling thread meanwhile.
+    void wait();
+
+    // Returns the number of worker threads.
+    int size() const { return (int)workers.size(); }
+
+    // Returns the process-wide pool, with one worker per hardware thread, started on first use.
+    static WorkStealingPool& shared();
+
+    // Returns whether the calling thread is a pool worker (a task that waits on its own pool never finishes).
+    static bool onWorkerThread();
+};